@@ -0,0 +1,50 @@
+#include "BusFleet.h"
+#include "FleetKernels.h"
+#include "ThreadPool.h"
+
+void BusFleet::reset(int count, const BusRoute& route) {
+	stationIndex.assign(count, 0);
+	isWaiting.assign(count, 1);
+	waitTimer.assign(count, 0.0f);
+	segmentTime.assign(count, 0.0f);
+	doorAngle.assign(count, 0.0f);
+	routeDistance.resize(count);
+	pathCursor.assign(count, 0);
+	busX.resize(count);
+	busY.resize(count);
+
+	for (int i = 0; i < count; ++i) {
+		int station = i % route.numStations;
+		stationIndex[i] = station;
+		waitTimer[i] = STATION_WAIT_SECONDS * (float)((i / route.numStations) % 16) / 16.0f;
+		routeDistance[i] = route.stationDistance[station];
+		busX[i] = route.stationPositions[2 * station];
+		busY[i] = route.stationPositions[2 * station + 1];
+	}
+}
+
+void updateFleetRange(BusFleet& fleet, const BusRoute& route, float deltaTime, int begin, int end) {
+	stepFleetKernel(fleet, route, deltaTime, begin, end);
+}
+
+void updateFleetPositions(BusFleet& fleet, const BusRoute& route, int begin, int end, bool afterEachStep) {
+	// Izmedju dva poziva autobus se krece samo unapred, pa kursor nalazi deonicu u O(1).
+	// waitTimer je 0 samo u koraku dolaska, kada se autobus jos jednom postavlja na stanicu.
+	const RoutePath& path = route.path;
+	for (int i = begin; i < end; ++i) {
+		if (afterEachStep && fleet.isWaiting[i] && fleet.waitTimer[i] > 0.0f) continue;
+		float distance = path.wrap(fleet.routeDistance[i]);
+		int segment = path.findSegment(distance, fleet.pathCursor[i]);
+		path.pointOnSegment(segment, distance, fleet.busX[i], fleet.busY[i]);
+	}
+}
+
+void updateFleet(BusFleet& fleet, const BusRoute& route, float deltaTime) {
+	updateFleetRange(fleet, route, deltaTime, 0, fleet.size());
+}
+
+void updateFleetParallel(BusFleet& fleet, const BusRoute& route, float deltaTime, ThreadPool& pool) {
+	pool.parallelFor(fleet.size(), FLEET_CHUNK_SIZE, [&](int begin, int end) {
+		updateFleetRange(fleet, route, deltaTime, begin, end);
+	});
+}
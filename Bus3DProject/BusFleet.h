@@ -0,0 +1,41 @@
+#pragma once
+#include <vector>
+#include "BusSimulation.h"
+
+// Vozni park na jednoj liniji, cuvan kao niz po polju (structure-of-arrays)
+// da bi jedan prolaz azuriranja isao linearno kroz memoriju.
+struct BusFleet {
+	std::vector<int> stationIndex;
+	std::vector<unsigned char> isWaiting;
+	std::vector<float> waitTimer;
+	std::vector<float> segmentTime;
+	std::vector<float> doorAngle;
+	// Predjeni put na putanji linije i poslednja deonica putanje (kursor za pretragu)
+	std::vector<float> routeDistance;
+	std::vector<int> pathCursor;
+	std::vector<float> busX;
+	std::vector<float> busY;
+
+	int size() const { return (int)stationIndex.size(); }
+
+	// Autobusi se rasporedjuju po stanicama i pomerenim vremenima cekanja
+	void reset(int count, const BusRoute& route);
+};
+
+// Isto ponasanje kao BusSimulation::update, ali za autobuse [begin, end)
+void updateFleetRange(BusFleet& fleet, const BusRoute& route, float deltaTime, int begin, int end);
+void updateFleet(BusFleet& fleet, const BusRoute& route, float deltaTime);
+
+// Korak azurira samo routeDistance; busX/busY se racunaju po potrebi,
+// samo za autobuse koji se crtaju ili uzorkuju. Ako se poziva posle svakog
+// koraka (afterEachStep), autobusi koji vec stoje na stanici se preskacu,
+// kao u BusSimulation::update.
+void updateFleetPositions(BusFleet& fleet, const BusRoute& route, int begin, int end, bool afterEachStep = false);
+
+class ThreadPool;
+
+// Vozni park se deli na delove fiksne velicine koji se obradjuju na svim jezgrima.
+// Autobusi su medjusobno nezavisni, pa je rezultat bit-identican updateFleet
+// bez obzira na broj niti.
+const int FLEET_CHUNK_SIZE = 4096;
+void updateFleetParallel(BusFleet& fleet, const BusRoute& route, float deltaTime, ThreadPool& pool);
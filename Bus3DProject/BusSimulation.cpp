@@ -0,0 +1,144 @@
+#include "BusSimulation.h"
+#include <iostream>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static float randomOffset(Pcg32& rng, float range) {
+	return (rng.nextFloat() * 2.0f - 1.0f) * range;
+}
+
+BusRoute createEllipseRoute(int numStations, float a, float b, int curvePointsPerSegment, float wiggleRange) {
+	Pcg32 rng = randomStream(RANDOM_STREAM_ROUTE);
+	BusRoute route;
+	route.numStations = numStations;
+	route.ownedStations.resize(numStations * 2);
+	for (int i = 0; i < numStations; ++i) {
+		float angle = i * 2 * M_PI / numStations;
+		route.ownedStations[2 * i] = cos(angle) * a;
+		route.ownedStations[2 * i + 1] = sin(angle) * b;
+	}
+
+	const float* stationPositions = route.ownedStations.data();
+	std::vector<float> pathVertices;
+	for (int i = 0; i < numStations; ++i) {
+		float x1 = stationPositions[2 * i];
+		float y1 = stationPositions[2 * i + 1];
+		float x2 = stationPositions[2 * ((i + 1) % numStations)];
+		float y2 = stationPositions[2 * ((i + 1) % numStations) + 1];
+		pathVertices.push_back(x1);
+		pathVertices.push_back(y1);
+		for (int j = 1; j < curvePointsPerSegment; ++j) {
+			float t = (float)j / curvePointsPerSegment;
+			float interX = x1 * (1.0f - t) + x2 * t;
+			float interY = y1 * (1.0f - t) + y2 * t;
+			float wiggleFactor = sin(t * M_PI);
+			pathVertices.push_back(interX + randomOffset(rng, wiggleRange * wiggleFactor));
+			pathVertices.push_back(interY + randomOffset(rng, wiggleRange * wiggleFactor));
+		}
+	}
+	route.path.build(pathVertices.data(), (int)pathVertices.size() / 2);
+	route.ownedDistances.resize(numStations);
+	for (int i = 0; i < numStations; ++i)
+		route.ownedDistances[i] = route.path.cumulativeLength[i * curvePointsPerSegment];
+	route.stationPositions = route.ownedStations.data();
+	route.stationDistance = route.ownedDistances.data();
+	return route;
+}
+
+BusRenderState interpolateRenderState(const BusRenderState& previous, const BusRenderState& current, float alpha) {
+	BusRenderState state;
+	state.busX = previous.busX * (1.0f - alpha) + current.busX * alpha;
+	state.busY = previous.busY * (1.0f - alpha) + current.busY * alpha;
+	state.doorAngle = previous.doorAngle * (1.0f - alpha) + current.doorAngle * alpha;
+	return state;
+}
+
+int FixedTimestep::advance(double frameSeconds) {
+	accumulator += frameSeconds;
+	int ticks = (int)(accumulator / tickSeconds);
+	if (ticks > maxCatchUpTicks) {
+		ticks = maxCatchUpTicks;
+		accumulator = fmod(accumulator, (double)tickSeconds);
+	}
+	else {
+		accumulator -= ticks * (double)tickSeconds;
+	}
+	return ticks;
+}
+
+void BusSimulation::reset(const BusRoute& r, int bus) {
+	*this = BusSimulation();
+	route = &r;
+	rng = randomStream(RANDOM_STREAM_DRIVER + (uint64_t)bus);
+	busX = r.stationPositions[0];
+	busY = r.stationPositions[1];
+}
+
+void BusSimulation::update(float deltaTime) {
+	// Animacija vrata
+	if (isWaiting) {
+		if (doorAngle < DOOR_OPEN_ANGLE) {
+			doorAngle += DOOR_ANIMATION_SPEED * deltaTime;
+			if (doorAngle > DOOR_OPEN_ANGLE) doorAngle = DOOR_OPEN_ANGLE;
+		}
+	}
+	else {
+		if (doorAngle > 0.0f) {
+			doorAngle -= DOOR_ANIMATION_SPEED * deltaTime;
+			if (doorAngle < 0.0f) doorAngle = 0.0f;
+		}
+	}
+
+	if (isWaiting) {
+		waitTimer += deltaTime;
+		if (waitTimer >= STATION_WAIT_SECONDS) {
+			isWaiting = false;
+			currentSegmentTime = 0.0f;
+			waitTimer = 0.0f;
+			currentStationIndex = (currentStationIndex + 1) % route->numStations;
+		}
+	}
+	else {
+		currentSegmentTime += deltaTime;
+		float t = currentSegmentTime / TRAVEL_TIME_SECONDS;
+		if (t >= 1.0f) {
+			if (showControls) {
+				passengersNumber -= punishmentNumber + 1;
+				std::cout << "Kazna: " << punishmentNumber << " | Preostali putnici: " << passengersNumber << std::endl;
+				showControls = false;
+				punishmentNumber = 0;
+			}
+			t = 1.0f;
+			isWaiting = true;
+			completedSegments++;
+		}
+		// Autobus prati nacrtanu putanju konstantnom brzinom
+		float distance = route->path.wrap(routeDistance(*route, currentStationIndex, t));
+		int segment = route->path.findSegment(distance, pathCursor);
+		route->path.pointOnSegment(segment, distance, busX, busY);
+	}
+}
+
+bool BusSimulation::startControl() {
+	if (!isWaiting || showControls) return false;
+	showControls = true;
+	if (passengersNumber != 0)
+		punishmentNumber = (int)rng.nextBelow(passengersNumber);
+	passengersNumber++;
+	return true;
+}
+
+bool BusSimulation::addPassenger() {
+	if (!isWaiting || passengersNumber >= MAX_PASSENGERS) return false;
+	passengersNumber++;
+	return true;
+}
+
+bool BusSimulation::removePassenger() {
+	if (!isWaiting || passengersNumber <= 0) return false;
+	passengersNumber--;
+	return true;
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include <vector>
+#include "Random.h"
+#include "RoutePath.h"
+#include "MappedFile.h"
+
+// Simulacija autobusa bez ikakve zavisnosti od GLFW/GLEW, tako da moze da
+// se pokrece i na serverima bez ekrana (vidi Headless.cpp).
+
+const float TRAVEL_TIME_SECONDS = 5.0f;
+const float STATION_WAIT_SECONDS = 10.0f;
+const float DOOR_OPEN_ANGLE = 90.0f;
+const float DOOR_ANIMATION_SPEED = 120.0f;
+const int MAX_PASSENGERS = 50;
+
+// Linija: pozicije stanica (x, y parovi), udaljenost svake stanice od pocetka
+// putanje i zatvorena putanja sa tabelom duzine luka. Podaci su ili generisani
+// u memoriji (createEllipseRoute) ili se citaju direktno iz mapiranog fajla (RouteFile.h).
+struct BusRoute {
+	const float* stationPositions = nullptr;
+	const float* stationDistance = nullptr;
+	int numStations = 0;
+	RoutePath path;
+
+	// Memorija na koju pokazuju pokazivaci iznad
+	std::vector<float> ownedStations;
+	std::vector<float> ownedDistances;
+	MappedFile file;
+
+	BusRoute() = default;
+	BusRoute(BusRoute&&) = default;
+	BusRoute& operator=(BusRoute&&) = default;
+	BusRoute(const BusRoute&) = delete;
+	BusRoute& operator=(const BusRoute&) = delete;
+};
+
+// Udaljenost na putanji za autobus koji ide ka stanici station, t u [0, 1].
+// Deonica ka stanici 0 zavrsava se na ukupnoj duzini (zatvoren krug).
+inline float routeDistance(const BusRoute& route, int station, float t) {
+	int previous = (station == 0) ? route.numStations - 1 : station - 1;
+	float start = route.stationDistance[previous];
+	float end = (station == 0) ? route.path.totalLength() : route.stationDistance[station];
+	return start * (1.0f - t) + end * t;
+}
+
+// Elipsa sa stanicama na jednakim uglovima, putanja je "vijugava" izmedju stanica
+BusRoute createEllipseRoute(int numStations, float a, float b, int curvePointsPerSegment, float wiggleRange);
+
+// Deo stanja koji se crta; renderuje se interpolacija izmedju dva poslednja koraka
+struct BusRenderState {
+	float busX = 0.0f;
+	float busY = 0.0f;
+	float doorAngle = 0.0f;
+};
+
+BusRenderState interpolateRenderState(const BusRenderState& previous, const BusRenderState& current, float alpha);
+
+struct BusSimulation {
+	const BusRoute* route = nullptr;
+
+	int currentStationIndex = 0;
+	float currentSegmentTime = 0.0f;
+	bool isWaiting = true;
+	float waitTimer = 0.0f;
+	int passengersNumber = 0;
+	int punishmentNumber = 0;
+	bool showControls = false;
+	float doorAngle = 0.0f;
+	float busX = 0.0f;
+	float busY = 0.0f;
+	// Poslednja deonica putanje, za pretragu u O(1)
+	int pathCursor = 0;
+
+	// Broj zavrsenih voznji izmedju dve stanice (za statistiku)
+	long long completedSegments = 0;
+
+	// Kazna pri kontroli karata se izvlaci iz toka vozaca ovog autobusa
+	Pcg32 rng;
+
+	void reset(const BusRoute& r, int bus = 0);
+	void update(float deltaTime);
+	BusRenderState renderState() const { return { busX, busY, doorAngle }; }
+
+	// Akcije vozaca, dozvoljene samo dok autobus stoji na stanici
+	bool startControl();
+	bool addPassenger();
+	bool removePassenger();
+};
+
+// Akumulator za simulaciju sa fiksnim korakom: proteklo vreme frejma se pretvara
+// u ceo broj koraka, a ostatak odredjuje interpolaciju pri crtanju. Posle zastoja
+// (pomeranje prozora, zakasneli swap) izvrsava se najvise maxCatchUpTicks koraka,
+// a visak vremena se odbacuje.
+struct FixedTimestep {
+	float tickSeconds = 1.0f / 60.0f;
+	int maxCatchUpTicks = 8;
+	double accumulator = 0.0;
+
+	int advance(double frameSeconds);
+	// Udeo [0, 1) puta izmedju poslednja dva koraka
+	float alpha() const { return (float)(accumulator / tickSeconds); }
+};
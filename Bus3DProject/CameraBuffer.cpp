@@ -0,0 +1,33 @@
+#include "CameraBuffer.h"
+#include <glm/gtc/type_ptr.hpp>
+#include <iostream>
+
+void CameraBuffer::create() {
+	glGenBuffers(1, &buffer);
+	glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+	glBufferData(GL_UNIFORM_BUFFER, 2 * sizeof(glm::mat4), NULL, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_BLOCK_BINDING, buffer);
+}
+
+void CameraBuffer::destroy() {
+	glDeleteBuffers(1, &buffer);
+	buffer = 0;
+}
+
+void CameraBuffer::update(const glm::mat4& projection, const glm::mat4& view) {
+	glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(projection));
+	glBufferSubData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(view));
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void CameraBuffer::attach(const ShaderProgram& program) {
+	// GLSL 330 nema layout(binding = ...), pa se tacka vezivanja postavlja ovde
+	unsigned int index = glGetUniformBlockIndex(program.id(), "Camera");
+	if (index == GL_INVALID_INDEX) {
+		std::cout << "Program " << program.id() << " nema blok Camera" << std::endl;
+		return;
+	}
+	glUniformBlockBinding(program.id(), index, CAMERA_BLOCK_BINDING);
+}
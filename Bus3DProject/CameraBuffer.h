@@ -0,0 +1,22 @@
+#pragma once
+#include <glm/glm.hpp>
+#include "ShaderProgram.h"
+
+// Tacka vezivanja bloka "Camera" (basic.vert, texture.vert)
+const unsigned int CAMERA_BLOCK_BINDING = 0;
+
+// Uniform buffer sa projekcijom i pogledom, raspored std140:
+//   mat4 projection (offset 0), mat4 view (offset 64)
+// Puni se jednom po frejmu i vazi za sve programe koji imaju blok "Camera".
+class CameraBuffer {
+public:
+	void create();
+	void destroy();
+	void update(const glm::mat4& projection, const glm::mat4& view);
+
+	// Vezuje blok "Camera" programa za CAMERA_BLOCK_BINDING
+	static void attach(const ShaderProgram& program);
+
+private:
+	unsigned int buffer = 0;
+};
@@ -0,0 +1,56 @@
+#include "ColoredMesh.h"
+#include <GL/glew.h>
+#include <cstddef>
+
+void MeshBuilder::addQuad(const float* corners, const glm::vec3& color, float alpha, int part) {
+	unsigned int first = (unsigned int)vertices.size();
+	for (int i = 0; i < 4; ++i)
+		vertices.push_back({ corners[3 * i], corners[3 * i + 1], corners[3 * i + 2], color.x, color.y, color.z, alpha, (float)part });
+	bool translucent = alpha < 1.0f;
+	std::vector<unsigned int>& indices = translucent ? translucentIndices : opaqueIndices;
+	if (translucent) {
+		float center[3] = { 0.0f, 0.0f, 0.0f };
+		for (int i = 0; i < 4; ++i)
+			for (int axis = 0; axis < 3; ++axis)
+				center[axis] += 0.25f * corners[3 * i + axis];
+		translucentSurfaces.push_back({ (int)indices.size(), 6, glm::vec3(center[0], center[1], center[2]) });
+	}
+	const unsigned int quad[6] = { 0, 1, 2, 2, 3, 0 };
+	for (unsigned int index : quad)
+		indices.push_back(first + index);
+}
+
+void ColoredMesh::create(const MeshBuilder& builder) {
+	std::vector<unsigned int> indices = builder.opaqueIndices;
+	indices.insert(indices.end(), builder.translucentIndices.begin(), builder.translucentIndices.end());
+	opaqueCount = (int)builder.opaqueIndices.size();
+	surfaces = builder.translucentSurfaces;
+	for (MeshSurface& surface : surfaces)
+		surface.firstIndex += opaqueCount;
+
+	glGenVertexArrays(1, &vao);
+	glGenBuffers(1, &vbo);
+	glGenBuffers(1, &ebo);
+	glBindVertexArray(vao);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBufferData(GL_ARRAY_BUFFER, builder.vertices.size() * sizeof(ColoredVertex), builder.vertices.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(ColoredVertex), (void*)offsetof(ColoredVertex, x));
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(ColoredVertex), (void*)offsetof(ColoredVertex, r));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(ColoredVertex), (void*)offsetof(ColoredVertex, part));
+	glEnableVertexAttribArray(2);
+	glBindVertexArray(0);
+}
+
+void ColoredMesh::destroy() {
+	glDeleteVertexArrays(1, &vao);
+	glDeleteBuffers(1, &vbo);
+	glDeleteBuffers(1, &ebo);
+	vao = vbo = ebo = 0;
+	opaqueCount = 0;
+	surfaces.clear();
+}
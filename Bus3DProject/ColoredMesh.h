@@ -0,0 +1,50 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+
+// Teme sa bojom i providnoscu u atributima (basic.vert), bez uniformi po povrsi
+struct ColoredVertex {
+	float x, y, z;
+	float r, g, b, a;
+	float part; // indeks matrice u nizu model[] u basic.vert
+};
+
+// Providna povrs u baferu indeksa, sa centrom za sortiranje po dubini
+struct MeshSurface {
+	int firstIndex;
+	int indexCount;
+	glm::vec3 center;
+};
+
+// Skuplja staticnu geometriju u jedan niz temena. Indeksi neprovidnih povrsi
+// idu na pocetak bafera indeksa i crtaju se jednim pozivom; providne (alpha < 1)
+// su posle njih, svaka kao posebna povrs, da bi mogle da se sortiraju od
+// najdalje ka najblizoj (RenderQueue.h).
+struct MeshBuilder {
+	std::vector<ColoredVertex> vertices;
+	std::vector<unsigned int> opaqueIndices;
+	std::vector<unsigned int> translucentIndices;
+	std::vector<MeshSurface> translucentSurfaces; // firstIndex je u translucentIndices
+
+	// Cetvorougao a-b-c-d (corners: 4 x, y, z trojke) kao trouglovi a-b-c i c-d-a
+	void addQuad(const float* corners, const glm::vec3& color, float alpha, int part = 0);
+};
+
+class ColoredMesh {
+public:
+	void create(const MeshBuilder& builder);
+	void destroy();
+
+	unsigned int vertexArray() const { return vao; }
+	// Neprovidni indeksi su [0, opaqueIndexCount())
+	int opaqueIndexCount() const { return opaqueCount; }
+	// Providne povrsi, firstIndex u zajednickom baferu indeksa
+	const std::vector<MeshSurface>& translucent() const { return surfaces; }
+
+private:
+	unsigned int vao = 0;
+	unsigned int vbo = 0;
+	unsigned int ebo = 0;
+	int opaqueCount = 0;
+	std::vector<MeshSurface> surfaces;
+};
@@ -0,0 +1,108 @@
+#include "CookedAtlas.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+// FNV-1a, 64 bita
+static uint64_t hashBytes(uint64_t hash, const void* data, size_t size) {
+	const unsigned char* bytes = (const unsigned char*)data;
+	for (size_t i = 0; i < size; ++i)
+		hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+	return hash;
+}
+
+static uint64_t hashValue(uint64_t hash, int64_t value) {
+	return hashBytes(hash, &value, sizeof(value));
+}
+
+uint64_t cookedAtlasSourceHash() {
+	uint64_t hash = 0xCBF29CE484222325ull;
+	hash = hashValue(hash, ATLAS_PADDING);
+	hash = hashValue(hash, ATLAS_MAX_SPRITE_SIZE);
+	hash = hashValue(hash, ATLAS_MIP_LEVELS);
+	for (int i = 0; i < SPRITE_COUNT; ++i) {
+		// Fajl koji ne postoji daje -1, pa se ni tada ne poklapa sa skuvanim atlasom
+		std::error_code error;
+		int64_t size = (int64_t)std::filesystem::file_size(SPRITE_FILES[i], error);
+		if (error) size = -1;
+		int64_t modified = (int64_t)std::filesystem::last_write_time(SPRITE_FILES[i], error).time_since_epoch().count();
+		if (error) modified = -1;
+		hash = hashBytes(hash, SPRITE_FILES[i], strlen(SPRITE_FILES[i]) + 1);
+		hash = hashValue(hash, size);
+		hash = hashValue(hash, modified);
+		hash = hashValue(hash, SPRITE_MAX_SIZE[i]);
+	}
+	return hash;
+}
+
+bool writeCookedAtlas(const char* filePath, const std::vector<AtlasImage>& mips, const std::vector<AtlasRegion>& regions, uint64_t sourceHash) {
+	if (mips.empty() || mips.size() > (size_t)COOKED_ATLAS_MAX_LEVELS) return false;
+
+	CookedAtlasHeader header = {};
+	header.magic = COOKED_ATLAS_MAGIC;
+	header.version = COOKED_ATLAS_VERSION;
+	header.sourceHash = sourceHash;
+	header.spriteCount = (uint32_t)regions.size();
+	header.levelCount = (uint32_t)mips.size();
+	header.regionsOffset = sizeof(header);
+	uint32_t offset = header.regionsOffset + (uint32_t)(regions.size() * sizeof(AtlasRegion));
+	for (size_t i = 0; i < mips.size(); ++i) {
+		header.levelWidth[i] = (uint32_t)mips[i].width;
+		header.levelHeight[i] = (uint32_t)mips[i].height;
+		header.levelOffset[i] = offset;
+		offset += (uint32_t)mips[i].pixels.size();
+	}
+
+	FILE* file = fopen(filePath, "wb");
+	if (!file) {
+		std::cout << "Ne moze da se otvori fajl za upis: " << filePath << std::endl;
+		return false;
+	}
+	bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+		fwrite(regions.data(), sizeof(AtlasRegion), regions.size(), file) == regions.size();
+	for (const AtlasImage& mip : mips)
+		written = written && fwrite(mip.pixels.data(), 1, mip.pixels.size(), file) == mip.pixels.size();
+	written = (fclose(file) == 0) && written;
+	if (!written)
+		std::cout << "Greska pri upisu fajla: " << filePath << std::endl;
+	return written;
+}
+
+bool loadCookedAtlas(const char* filePath, CookedAtlas& atlas) {
+	MappedFile file;
+	if (!file.open(filePath))
+		return false;
+
+	CookedAtlasHeader header;
+	if (file.size() < sizeof(header)) {
+		std::cout << "Fajl atlasa je prekratak: " << filePath << std::endl;
+		return false;
+	}
+	memcpy(&header, file.data(), sizeof(header));
+	if (header.magic != COOKED_ATLAS_MAGIC || header.version != COOKED_ATLAS_VERSION ||
+		header.levelCount == 0 || header.levelCount > (uint32_t)COOKED_ATLAS_MAX_LEVELS) {
+		std::cout << "Nepoznat format fajla atlasa: " << filePath << std::endl;
+		return false;
+	}
+	bool valid = header.regionsOffset % 4 == 0 &&
+		(uint64_t)header.regionsOffset + (uint64_t)header.spriteCount * sizeof(AtlasRegion) <= file.size();
+	for (uint32_t i = 0; i < header.levelCount && valid; ++i) {
+		uint64_t bytes = 4ull * header.levelWidth[i] * header.levelHeight[i];
+		valid = bytes > 0 && (uint64_t)header.levelOffset[i] + bytes <= file.size();
+	}
+	if (!valid) {
+		std::cout << "Ostecen fajl atlasa: " << filePath << std::endl;
+		return false;
+	}
+
+	atlas.levels.clear();
+	for (uint32_t i = 0; i < header.levelCount; ++i)
+		atlas.levels.push_back({ (int)header.levelWidth[i], (int)header.levelHeight[i], file.data() + header.levelOffset[i] });
+	atlas.regions = (const AtlasRegion*)(file.data() + header.regionsOffset);
+	atlas.spriteCount = (int)header.spriteCount;
+	atlas.sourceHash = header.sourceHash;
+	// Premestanje mapiranja ne menja adrese, pokazivaci ostaju ispravni
+	atlas.file = std::move(file);
+	return true;
+}
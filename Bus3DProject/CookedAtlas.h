@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "MappedFile.h"
+#include "TextureAtlas.h"
+
+// "Skuvan" atlas: vec umanjene i spakovane slike sa celim mip lancem u sirovom
+// RGBA8 obliku. Pri pokretanju se fajl samo mapira i nivoi idu pravo u
+// glTexImage2D, bez dekodiranja PNG/JPEG i bez racunanja mipova.
+// Zaglavlje cuva otisak izvornih slika i postavki atlasa; ako se ne poklapa sa
+// trenutnim, atlas je zastareo i slike se ponovo dekodiraju.
+
+const uint32_t COOKED_ATLAS_MAGIC = 0x4B415442; // "BTAK"
+const uint32_t COOKED_ATLAS_VERSION = 2;
+const int COOKED_ATLAS_MAX_LEVELS = 16;
+// Odavde se atlas ucitava ako nije zadat --assets
+const char* const COOKED_ATLAS_DEFAULT_PATH = "res/sprites.cooked";
+
+struct CookedAtlasHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t sourceHash;    // cookedAtlasSourceHash() u trenutku kuvanja
+	uint32_t spriteCount;
+	uint32_t levelCount;
+	uint32_t regionsOffset; // AtlasRegion [spriteCount]
+	uint32_t levelWidth[COOKED_ATLAS_MAX_LEVELS];
+	uint32_t levelHeight[COOKED_ATLAS_MAX_LEVELS];
+	uint32_t levelOffset[COOKED_ATLAS_MAX_LEVELS]; // RGBA8, redovi odozdo nagore
+};
+
+struct CookedAtlas {
+	MappedFile file;
+	std::vector<AtlasLevel> levels;  // pokazuju u file
+	const AtlasRegion* regions = nullptr;
+	int spriteCount = 0;
+	uint64_t sourceHash = 0;
+};
+
+// Otisak SPRITE_FILES (putanja, velicina, vreme izmene i SPRITE_MAX_SIZE svakog
+// fajla) i konstanti ATLAS_PADDING, ATLAS_MAX_SPRITE_SIZE i ATLAS_MIP_LEVELS
+uint64_t cookedAtlasSourceHash();
+
+bool writeCookedAtlas(const char* filePath, const std::vector<AtlasImage>& mips, const std::vector<AtlasRegion>& regions, uint64_t sourceHash);
+// Proverava samo zaglavlje i granice; false ako fajl ne postoji ili nije ispravan
+bool loadCookedAtlas(const char* filePath, CookedAtlas& atlas);
@@ -0,0 +1,66 @@
+#include "EventDrivenFleet.h"
+#include <algorithm>
+
+void EventDrivenFleet::reset(int count, const BusRoute& r) {
+	route = &r;
+	stationIndex.assign(count, 0);
+	isWaiting.assign(count, 1);
+	phaseStart.assign(count, 0.0);
+	doorAngleAtEvent.assign(count, 0.0f);
+	lastEventTime.assign(count, 0.0);
+	events = decltype(events)();
+	now = 0.0;
+	processedEvents = 0;
+
+	for (int i = 0; i < count; ++i) {
+		stationIndex[i] = i % r.numStations;
+		// Autobus je vec proveo deo vremena na stanici
+		phaseStart[i] = -STATION_WAIT_SECONDS * (double)((i / r.numStations) % 16) / 16.0;
+		events.push({ phaseStart[i] + STATION_WAIT_SECONDS, i });
+	}
+}
+
+float EventDrivenFleet::doorAngleAt(int bus, double time) const {
+	float moved = DOOR_ANIMATION_SPEED * (float)(time - lastEventTime[bus]);
+	if (isWaiting[bus])
+		return std::min(doorAngleAtEvent[bus] + moved, DOOR_OPEN_ANGLE);
+	return std::max(doorAngleAtEvent[bus] - moved, 0.0f);
+}
+
+void EventDrivenFleet::advanceTo(double time) {
+	const int numStations = route->numStations;
+	while (!events.empty() && events.top().time <= time) {
+		BusEvent event = events.top();
+		events.pop();
+		int bus = event.bus;
+
+		doorAngleAtEvent[bus] = doorAngleAt(bus, event.time);
+		lastEventTime[bus] = event.time;
+		phaseStart[bus] = event.time;
+		if (isWaiting[bus]) {
+			isWaiting[bus] = 0;
+			stationIndex[bus] = (stationIndex[bus] + 1) % numStations;
+			events.push({ event.time + TRAVEL_TIME_SECONDS, bus });
+		}
+		else {
+			isWaiting[bus] = 1;
+			events.push({ event.time + STATION_WAIT_SECONDS, bus });
+		}
+		processedEvents++;
+	}
+	now = time;
+}
+
+void EventDrivenFleet::sample(std::vector<float>& busX, std::vector<float>& busY, std::vector<float>& doorAngle) const {
+	const RoutePath& path = route->path;
+	int count = size();
+	busX.resize(count);
+	busY.resize(count);
+	doorAngle.resize(count);
+	for (int i = 0; i < count; ++i) {
+		float t = isWaiting[i] ? 1.0f : std::min((float)(now - phaseStart[i]) / TRAVEL_TIME_SECONDS, 1.0f);
+		float distance = path.wrap(routeDistance(*route, stationIndex[i], t));
+		path.pointOnSegment(path.findSegment(distance), distance, busX[i], busY[i]);
+		doorAngle[i] = doorAngleAt(i, now);
+	}
+}
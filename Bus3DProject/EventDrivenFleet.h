@@ -0,0 +1,46 @@
+#pragma once
+#include <functional>
+#include <queue>
+#include <vector>
+#include "BusSimulation.h"
+
+// Vozni park vodjen dogadjajima: autobus samo ceka STATION_WAIT_SECONDS ili vozi
+// TRAVEL_TIME_SECONDS, pa se umesto koraka po frejmu cuva red sledecih polazaka
+// i dolazaka i vreme skace direktno sa dogadjaja na dogadjaj. Pozicije se racunaju
+// samo kada se zatraze (crtanje ili uzorkovanje).
+struct BusEvent {
+	double time;
+	int bus;
+
+	// Isti trenutak se razresava po indeksu autobusa, da bi redosled bio ponovljiv
+	bool operator>(const BusEvent& other) const {
+		return time > other.time || (time == other.time && bus > other.bus);
+	}
+};
+
+struct EventDrivenFleet {
+	const BusRoute* route = nullptr;
+
+	std::vector<int> stationIndex;
+	std::vector<unsigned char> isWaiting;
+	// Pocetak trenutnog cekanja/voznje
+	std::vector<double> phaseStart;
+	// Ugao vrata u trenutku poslednjeg dogadjaja, vrata se odatle animiraju analiticki
+	std::vector<float> doorAngleAtEvent;
+	std::vector<double> lastEventTime;
+
+	// Sledeci dogadjaj svakog autobusa (polazak ako ceka, inace dolazak)
+	std::priority_queue<BusEvent, std::vector<BusEvent>, std::greater<BusEvent>> events;
+	double now = 0.0;
+	long long processedEvents = 0;
+
+	int size() const { return (int)stationIndex.size(); }
+
+	// Isti pocetni raspored kao BusFleet::reset
+	void reset(int count, const BusRoute& r);
+	void advanceTo(double time);
+
+	float doorAngleAt(int bus, double time) const;
+	// Pozicije i uglovi vrata svih autobusa u trenutku now
+	void sample(std::vector<float>& busX, std::vector<float>& busY, std::vector<float>& doorAngle) const;
+};
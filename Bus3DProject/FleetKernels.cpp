@@ -0,0 +1,264 @@
+#include "FleetKernels.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define FLEET_KERNELS_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define FLEET_TARGET_AVX2
+#else
+#define FLEET_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+// Pokazivaci na polja voznog parka, pomereni na pocetak opsega
+struct FleetSpan {
+	int* stationIndex;
+	unsigned char* isWaiting;
+	float* waitTimer;
+	float* segmentTime;
+	float* doorAngle;
+	float* routeDistance;
+	int count;
+};
+
+static FleetSpan fleetSpan(BusFleet& fleet, int begin, int end) {
+	return { fleet.stationIndex.data() + begin, fleet.isWaiting.data() + begin, fleet.waitTimer.data() + begin,
+		fleet.segmentTime.data() + begin, fleet.doorAngle.data() + begin, fleet.routeDistance.data() + begin,
+		end - begin };
+}
+
+static FleetSpan advanceSpan(const FleetSpan& s, int offset) {
+	return { s.stationIndex + offset, s.isWaiting + offset, s.waitTimer + offset, s.segmentTime + offset,
+		s.doorAngle + offset, s.routeDistance + offset, s.count - offset };
+}
+
+// Napomena: nijedna varijanta ne koristi FMA i sve rade iste operacije istim
+// redom, da bi rezultati bili bit-identicni skalarnoj.
+
+// --- SKALARNO ---
+static void stepScalar(const FleetSpan& s, const float* stationDistance, int numStations, float totalLength, float deltaTime) {
+	const float doorStep = DOOR_ANIMATION_SPEED * deltaTime;
+	for (int i = 0; i < s.count; ++i) {
+		bool waiting = s.isWaiting[i] != 0;
+		float opening = std::min(s.doorAngle[i] + doorStep, DOOR_OPEN_ANGLE);
+		float closing = std::max(s.doorAngle[i] - doorStep, 0.0f);
+		s.doorAngle[i] = waiting ? opening : closing;
+
+		float waitTimer = s.waitTimer[i] + (waiting ? deltaTime : 0.0f);
+		float segmentTime = s.segmentTime[i] + (waiting ? 0.0f : deltaTime);
+		bool departs = waiting && waitTimer >= STATION_WAIT_SECONDS;
+		bool arrives = !waiting && segmentTime / TRAVEL_TIME_SECONDS >= 1.0f;
+		int station = s.stationIndex[i];
+		if (departs) {
+			station = (station + 1 == numStations) ? 0 : station + 1;
+			waitTimer = 0.0f;
+			segmentTime = 0.0f;
+		}
+		waiting = (waiting && !departs) || arrives;
+		s.stationIndex[i] = station;
+		s.isWaiting[i] = waiting ? 1 : 0;
+		s.waitTimer[i] = waitTimer;
+		s.segmentTime[i] = segmentTime;
+
+		// Dok autobus ceka t = 1, pa ostaje na trenutnoj stanici
+		float t = waiting ? 1.0f : std::min(segmentTime / TRAVEL_TIME_SECONDS, 1.0f);
+		float start = stationDistance[station == 0 ? numStations - 1 : station - 1];
+		float end = (station == 0) ? totalLength : stationDistance[station];
+		s.routeDistance[i] = start * (1.0f - t) + end * t;
+	}
+}
+
+#ifdef FLEET_KERNELS_X86
+// --- SSE2 (4 autobusa po instrukciji) ---
+static __m128i select4i(__m128i mask, __m128i a, __m128i b) {
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+static __m128 select4(__m128 mask, __m128 a, __m128 b) {
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static void stepSSE2(const FleetSpan& s, const float* stationDistance, int numStations, float totalLength, float deltaTime) {
+	const __m128 vDt = _mm_set1_ps(deltaTime);
+	const __m128 vDoorStep = _mm_set1_ps(DOOR_ANIMATION_SPEED * deltaTime);
+	const __m128 vOpen = _mm_set1_ps(DOOR_OPEN_ANGLE);
+	const __m128 vWait = _mm_set1_ps(STATION_WAIT_SECONDS);
+	const __m128 vTravel = _mm_set1_ps(TRAVEL_TIME_SECONDS);
+	const __m128 vOne = _mm_set1_ps(1.0f);
+	const __m128 vZero = _mm_setzero_ps();
+	const __m128i vZeroI = _mm_setzero_si128();
+	const __m128i vOneI = _mm_set1_epi32(1);
+	const __m128i vCount = _mm_set1_epi32(numStations);
+	int i = 0;
+	for (; i + 4 <= s.count; i += 4) {
+		int packed;
+		memcpy(&packed, s.isWaiting + i, sizeof(packed));
+		__m128i waitingI = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), vZeroI), vZeroI);
+		__m128 waiting = _mm_castsi128_ps(_mm_cmpgt_epi32(waitingI, vZeroI));
+
+		__m128 door = _mm_loadu_ps(s.doorAngle + i);
+		__m128 opening = _mm_min_ps(_mm_add_ps(door, vDoorStep), vOpen);
+		__m128 closing = _mm_max_ps(_mm_sub_ps(door, vDoorStep), vZero);
+		_mm_storeu_ps(s.doorAngle + i, select4(waiting, opening, closing));
+
+		__m128 waitTimer = _mm_add_ps(_mm_loadu_ps(s.waitTimer + i), _mm_and_ps(waiting, vDt));
+		__m128 segmentTime = _mm_add_ps(_mm_loadu_ps(s.segmentTime + i), _mm_andnot_ps(waiting, vDt));
+		__m128 departs = _mm_and_ps(waiting, _mm_cmpge_ps(waitTimer, vWait));
+		__m128 arrives = _mm_andnot_ps(waiting, _mm_cmpge_ps(_mm_div_ps(segmentTime, vTravel), vOne));
+
+		__m128i station = _mm_loadu_si128((const __m128i*)(s.stationIndex + i));
+		__m128i next = _mm_add_epi32(station, vOneI);
+		next = _mm_andnot_si128(_mm_cmpeq_epi32(next, vCount), next);
+		station = select4i(_mm_castps_si128(departs), next, station);
+		waitTimer = _mm_andnot_ps(departs, waitTimer);
+		segmentTime = _mm_andnot_ps(departs, segmentTime);
+		waiting = _mm_or_ps(_mm_andnot_ps(departs, waiting), arrives);
+
+		_mm_storeu_si128((__m128i*)(s.stationIndex + i), station);
+		_mm_storeu_ps(s.waitTimer + i, waitTimer);
+		_mm_storeu_ps(s.segmentTime + i, segmentTime);
+		__m128i waitingBytes = _mm_and_si128(_mm_castps_si128(waiting), vOneI);
+		waitingBytes = _mm_packus_epi16(_mm_packs_epi32(waitingBytes, waitingBytes), vZeroI);
+		packed = _mm_cvtsi128_si32(waitingBytes);
+		memcpy(s.isWaiting + i, &packed, sizeof(packed));
+
+		// SSE2 nema gather, krajevi deonice se skupljaju skalarno
+		alignas(16) int endIdx[4];
+		alignas(16) float start[4], end[4];
+		_mm_store_si128((__m128i*)endIdx, station);
+		for (int k = 0; k < 4; ++k) {
+			start[k] = stationDistance[endIdx[k] == 0 ? numStations - 1 : endIdx[k] - 1];
+			end[k] = (endIdx[k] == 0) ? totalLength : stationDistance[endIdx[k]];
+		}
+		__m128 t = select4(waiting, vOne, _mm_min_ps(_mm_div_ps(segmentTime, vTravel), vOne));
+		__m128 oneMinusT = _mm_sub_ps(vOne, t);
+		_mm_storeu_ps(s.routeDistance + i, _mm_add_ps(_mm_mul_ps(_mm_load_ps(start), oneMinusT), _mm_mul_ps(_mm_load_ps(end), t)));
+	}
+	stepScalar(advanceSpan(s, i), stationDistance, numStations, totalLength, deltaTime);
+}
+
+// --- AVX2 (8 autobusa po instrukciji) ---
+FLEET_TARGET_AVX2 static void stepAVX2(const FleetSpan& s, const float* stationDistance, int numStations, float totalLength, float deltaTime) {
+	const __m256 vDt = _mm256_set1_ps(deltaTime);
+	const __m256 vDoorStep = _mm256_set1_ps(DOOR_ANIMATION_SPEED * deltaTime);
+	const __m256 vOpen = _mm256_set1_ps(DOOR_OPEN_ANGLE);
+	const __m256 vWait = _mm256_set1_ps(STATION_WAIT_SECONDS);
+	const __m256 vTravel = _mm256_set1_ps(TRAVEL_TIME_SECONDS);
+	const __m256 vOne = _mm256_set1_ps(1.0f);
+	const __m256 vZero = _mm256_setzero_ps();
+	const __m256i vZeroI = _mm256_setzero_si256();
+	const __m256i vOneI = _mm256_set1_epi32(1);
+	const __m256i vCount = _mm256_set1_epi32(numStations);
+	const __m256i vLast = _mm256_set1_epi32(numStations - 1);
+	const __m256 vTotal = _mm256_set1_ps(totalLength);
+	int i = 0;
+	for (; i + 8 <= s.count; i += 8) {
+		__m256i waitingI = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(s.isWaiting + i)));
+		__m256 waiting = _mm256_castsi256_ps(_mm256_cmpgt_epi32(waitingI, vZeroI));
+
+		__m256 door = _mm256_loadu_ps(s.doorAngle + i);
+		__m256 opening = _mm256_min_ps(_mm256_add_ps(door, vDoorStep), vOpen);
+		__m256 closing = _mm256_max_ps(_mm256_sub_ps(door, vDoorStep), vZero);
+		_mm256_storeu_ps(s.doorAngle + i, _mm256_blendv_ps(closing, opening, waiting));
+
+		__m256 waitTimer = _mm256_add_ps(_mm256_loadu_ps(s.waitTimer + i), _mm256_and_ps(waiting, vDt));
+		__m256 segmentTime = _mm256_add_ps(_mm256_loadu_ps(s.segmentTime + i), _mm256_andnot_ps(waiting, vDt));
+		__m256 departs = _mm256_and_ps(waiting, _mm256_cmp_ps(waitTimer, vWait, _CMP_GE_OQ));
+		__m256 arrives = _mm256_andnot_ps(waiting, _mm256_cmp_ps(_mm256_div_ps(segmentTime, vTravel), vOne, _CMP_GE_OQ));
+
+		__m256i station = _mm256_loadu_si256((const __m256i*)(s.stationIndex + i));
+		__m256i next = _mm256_add_epi32(station, vOneI);
+		next = _mm256_andnot_si256(_mm256_cmpeq_epi32(next, vCount), next);
+		station = _mm256_blendv_epi8(station, next, _mm256_castps_si256(departs));
+		waitTimer = _mm256_andnot_ps(departs, waitTimer);
+		segmentTime = _mm256_andnot_ps(departs, segmentTime);
+		waiting = _mm256_or_ps(_mm256_andnot_ps(departs, waiting), arrives);
+
+		_mm256_storeu_si256((__m256i*)(s.stationIndex + i), station);
+		_mm256_storeu_ps(s.waitTimer + i, waitTimer);
+		_mm256_storeu_ps(s.segmentTime + i, segmentTime);
+		__m256i waitingBits = _mm256_and_si256(_mm256_castps_si256(waiting), vOneI);
+		__m128i waitingWords = _mm_packs_epi32(_mm256_castsi256_si128(waitingBits), _mm256_extracti128_si256(waitingBits, 1));
+		_mm_storel_epi64((__m128i*)(s.isWaiting + i), _mm_packus_epi16(waitingWords, waitingWords));
+
+		__m256i toFirst = _mm256_cmpeq_epi32(station, vZeroI);
+		__m256i startIdx = _mm256_blendv_epi8(_mm256_sub_epi32(station, vOneI), vLast, toFirst);
+		__m256 start = _mm256_i32gather_ps(stationDistance, startIdx, 4);
+		__m256 end = _mm256_blendv_ps(_mm256_i32gather_ps(stationDistance, station, 4), vTotal, _mm256_castsi256_ps(toFirst));
+
+		__m256 t = _mm256_blendv_ps(_mm256_min_ps(_mm256_div_ps(segmentTime, vTravel), vOne), vOne, waiting);
+		__m256 oneMinusT = _mm256_sub_ps(vOne, t);
+		_mm256_storeu_ps(s.routeDistance + i, _mm256_add_ps(_mm256_mul_ps(start, oneMinusT), _mm256_mul_ps(end, t)));
+	}
+	stepScalar(advanceSpan(s, i), stationDistance, numStations, totalLength, deltaTime);
+}
+
+static bool cpuSupportsAVX2() {
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7) return false;
+	__cpuid(info, 1);
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	bool avx = (info[2] & (1 << 28)) != 0;
+	if (!osxsave || !avx) return false;
+	// OS mora da cuva YMM registre
+	if ((_xgetbv(0) & 6) != 6) return false;
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+// --- DISPATCH ---
+typedef void (*FleetStepFn)(const FleetSpan&, const float*, int, float, float);
+
+static FleetStepFn kernelFor(FleetKernelIsa isa) {
+#ifdef FLEET_KERNELS_X86
+	if (isa == FleetKernelIsa::AVX2) return stepAVX2;
+	if (isa == FleetKernelIsa::SSE2) return stepSSE2;
+#endif
+	return stepScalar;
+}
+
+FleetKernelIsa bestFleetKernelIsa() {
+#ifdef FLEET_KERNELS_X86
+	// SSE2 je deo osnovnog x86-64 skupa instrukcija
+	static const FleetKernelIsa best = cpuSupportsAVX2() ? FleetKernelIsa::AVX2 : FleetKernelIsa::SSE2;
+	return best;
+#else
+	return FleetKernelIsa::Scalar;
+#endif
+}
+
+static FleetKernelIsa activeIsa = bestFleetKernelIsa();
+static FleetStepFn activeStep = kernelFor(activeIsa);
+
+FleetKernelIsa activeFleetKernelIsa() {
+	return activeIsa;
+}
+
+bool setFleetKernelIsa(FleetKernelIsa isa) {
+	if ((int)isa > (int)bestFleetKernelIsa()) return false;
+	activeIsa = isa;
+	activeStep = kernelFor(isa);
+	return true;
+}
+
+const char* fleetKernelIsaName(FleetKernelIsa isa) {
+	switch (isa) {
+	case FleetKernelIsa::AVX2: return "AVX2";
+	case FleetKernelIsa::SSE2: return "SSE2";
+	default: return "skalarno";
+	}
+}
+
+void stepFleetKernel(BusFleet& fleet, const BusRoute& route, float deltaTime, int begin, int end) {
+	activeStep(fleetSpan(fleet, begin, end), route.stationDistance, route.numStations, route.path.totalLength(), deltaTime);
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include "BusFleet.h"
+
+// Vektorski kernel za korak voznog parka: animacija vrata, tajmeri cekanja/voznje,
+// prelazi stanja i interpolacija predjenog puta izmedju stanica, sve bez grananja.
+// Pozicija na putanji (BusFleet::busX/busY) se racuna po potrebi, vidi updateFleetPositions.
+// Implementacija (skalarna, SSE2 ili AVX2) bira se jednom, pri staticnoj inicijalizaciji
+// programa, na osnovu mogucnosti procesora, tako da isti izvrsni fajl radi i na starijim masinama.
+
+enum class FleetKernelIsa { Scalar, SSE2, AVX2 };
+
+// Isto ponasanje kao BusSimulation::update (bez kontrole karata) za autobuse [begin, end)
+void stepFleetKernel(BusFleet& fleet, const BusRoute& route, float deltaTime, int begin, int end);
+
+FleetKernelIsa bestFleetKernelIsa();
+FleetKernelIsa activeFleetKernelIsa();
+// Vraca false ako procesor ne podrzava trazeni skup instrukcija
+bool setFleetKernelIsa(FleetKernelIsa isa);
+const char* fleetKernelIsaName(FleetKernelIsa isa);
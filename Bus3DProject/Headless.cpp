@@ -0,0 +1,327 @@
+#include "Headless.h"
+#include "BusSimulation.h"
+#include "BusFleet.h"
+#include "FleetKernels.h"
+#include "ThreadPool.h"
+#include "Random.h"
+#include "EventDrivenFleet.h"
+#include "RouteFile.h"
+#include "TextureAtlas.h"
+#include "CookedAtlas.h"
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
+
+const char* findArg(int argc, char** argv, const char* name) {
+	for (int i = 1; i < argc; ++i) {
+		if (strcmp(argv[i], name) == 0)
+			return (i + 1 < argc) ? argv[i + 1] : "";
+	}
+	return nullptr;
+}
+
+uint64_t seedFromArgs(int argc, char** argv) {
+	const char* seedArg = findArg(argc, argv, "--seed");
+	return seedArg ? strtoull(seedArg, nullptr, 10) : (uint64_t)time(NULL);
+}
+
+bool isHeadlessRun(int argc, char** argv) {
+	return findArg(argc, argv, "--headless") != nullptr || findArg(argc, argv, "--bench-fleet") != nullptr ||
+		findArg(argc, argv, "--write-route") != nullptr || findArg(argc, argv, "--write-atlas") != nullptr ||
+		findArg(argc, argv, "--cook-assets") != nullptr;
+}
+
+bool routeFromArgs(int argc, char** argv, BusRoute& route) {
+	const char* routeArg = findArg(argc, argv, "--route");
+	if (routeArg) {
+		const char* lineArg = findArg(argc, argv, "--line");
+		if (!loadRouteFile(routeArg, route, lineArg ? atoi(lineArg) : 0))
+			return false;
+		std::cout << "Linija: " << routeArg << " (" << route.numStations << " stanica, "
+			<< route.path.numSegments() << " deonica putanje)" << std::endl;
+		return true;
+	}
+
+	const char* stationsArg = findArg(argc, argv, "--stations");
+	int stations = stationsArg ? atoi(stationsArg) : 10;
+	if (stations < 2) {
+		std::cerr << "Broj stanica mora biti najmanje 2" << std::endl;
+		return false;
+	}
+	route = createEllipseRoute(stations, 0.8f, 0.5f, 5, 0.08f);
+	return true;
+}
+
+static int writeRoute(int argc, char** argv) {
+	const char* filePath = findArg(argc, argv, "--write-route");
+	if (!filePath || !*filePath) {
+		std::cerr << "Upotreba: --write-route <fajl> [--stations <n>] [--seed <n>]" << std::endl;
+		return -1;
+	}
+	initRandomSeed(seedFromArgs(argc, argv));
+	BusRoute route;
+	if (!routeFromArgs(argc, argv, route) || !writeRouteFile(filePath, route))
+		return -1;
+	std::cout << "Upisano: " << filePath << " (" << route.numStations << " stanica)" << std::endl;
+	return 0;
+}
+
+template <typename T>
+static bool sameArray(const std::vector<T>& a, const std::vector<T>& b) {
+	return a.size() == b.size() && memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+static bool fleetsIdentical(const BusFleet& a, const BusFleet& b) {
+	return sameArray(a.stationIndex, b.stationIndex) && sameArray(a.isWaiting, b.isWaiting) &&
+		sameArray(a.waitTimer, b.waitTimer) && sameArray(a.segmentTime, b.segmentTime) &&
+		sameArray(a.doorAngle, b.doorAngle) && sameArray(a.routeDistance, b.routeDistance) &&
+		sameArray(a.pathCursor, b.pathCursor) && sameArray(a.busX, b.busX) && sameArray(a.busY, b.busY);
+}
+
+// Poredi azuriranja/s: niz BusSimulation objekata (dosadasnji put) i BusFleet
+static int runFleetBenchmark(int argc, char** argv) {
+	int buses = atoi(findArg(argc, argv, "--bench-fleet"));
+	const char* secondsArg = findArg(argc, argv, "--seconds");
+	float simSeconds = secondsArg ? (float)atof(secondsArg) : 60.0f;
+	const float dt = 1.0f / 60.0f;
+	if (buses <= 0 || simSeconds <= 0.0f) {
+		std::cerr << "Upotreba: --bench-fleet <broj autobusa> [--seconds <simulirano vreme>]" << std::endl;
+		return -1;
+	}
+
+	initRandomSeed(seedFromArgs(argc, argv));
+	BusRoute route;
+	if (!routeFromArgs(argc, argv, route))
+		return -1;
+	int steps = (int)(simSeconds / dt);
+
+	BusFleet initial;
+	initial.reset(buses, route);
+	std::vector<BusSimulation> singles(buses);
+	for (int i = 0; i < buses; ++i) {
+		singles[i].reset(route, i);
+		singles[i].currentStationIndex = initial.stationIndex[i];
+		singles[i].waitTimer = initial.waitTimer[i];
+		singles[i].busX = initial.busX[i];
+		singles[i].busY = initial.busY[i];
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	for (int s = 0; s < steps; ++s)
+		for (BusSimulation& sim : singles)
+			sim.update(dt);
+	double singleSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	double updates = (double)buses * steps;
+	// BusSimulation::update racuna i poziciju, pa se ovde i za BusFleet posle svakog
+	// koraka racunaju pozicije istih autobusa (kao da se ceo vozni park crta)
+	std::cout << buses << " autobusa, " << steps << " koraka, sa pozicijama u svakom koraku" << std::endl;
+	std::cout << "BusSimulation:           " << updates / singleSeconds << " azuriranja/s (" << singleSeconds << " s)" << std::endl;
+
+	// Svaka varijanta kernela mora dati bit-identican rezultat kao skalarna
+	FleetKernelIsa best = bestFleetKernelIsa();
+	BusFleet reference;
+	for (int isa = (int)FleetKernelIsa::Scalar; isa <= (int)best; ++isa) {
+		setFleetKernelIsa((FleetKernelIsa)isa);
+		BusFleet fleet = initial;
+		start = std::chrono::steady_clock::now();
+		for (int s = 0; s < steps; ++s) {
+			updateFleet(fleet, route, dt);
+			updateFleetPositions(fleet, route, 0, fleet.size(), true);
+		}
+		double fleetSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		if (isa == (int)FleetKernelIsa::Scalar)
+			reference = fleet;
+		bool identical = fleetsIdentical(fleet, reference);
+
+		std::cout << "BusFleet (" << fleetKernelIsaName((FleetKernelIsa)isa) << "):";
+		for (int pad = (int)strlen(fleetKernelIsaName((FleetKernelIsa)isa)); pad < 12; ++pad) std::cout << ' ';
+		std::cout << updates / fleetSeconds << " azuriranja/s (" << fleetSeconds << " s) | ubrzanje "
+			<< singleSeconds / fleetSeconds << "x" << (identical ? "" : " | RAZLIKA u odnosu na skalarno!") << std::endl;
+	}
+	setFleetKernelIsa(best);
+
+	// Visenitno azuriranje mora dati isti rezultat za svaki broj niti
+	const char* threadsArg = findArg(argc, argv, "--threads");
+	int maxThreads = threadsArg ? atoi(threadsArg) : (int)std::thread::hardware_concurrency();
+	for (int threads = 1; threads <= maxThreads; threads *= 2) {
+		if (threads * 2 > maxThreads) threads = maxThreads;
+		ThreadPool pool(threads);
+		BusFleet fleet = initial;
+		start = std::chrono::steady_clock::now();
+		for (int s = 0; s < steps; ++s) {
+			updateFleetParallel(fleet, route, dt, pool);
+			pool.parallelFor(fleet.size(), FLEET_CHUNK_SIZE, [&](int begin, int end) {
+				updateFleetPositions(fleet, route, begin, end, true);
+			});
+		}
+		double fleetSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		std::cout << "BusFleet (" << fleetKernelIsaName(best) << ", " << threads << " niti): "
+			<< updates / fleetSeconds << " azuriranja/s (" << fleetSeconds << " s) | ubrzanje "
+			<< singleSeconds / fleetSeconds << "x" << (fleetsIdentical(fleet, reference) ? "" : " | RAZLIKA u odnosu na skalarno!") << std::endl;
+	}
+	return 0;
+}
+
+static void printThroughput(double hours, double wallSeconds) {
+	std::cout << "Vreme izvrsavanja: " << wallSeconds << " s";
+	if (wallSeconds > 0.0)
+		std::cout << " | " << hours * 3600.0 / wallSeconds << "x brze od realnog vremena";
+	std::cout << std::endl;
+}
+
+static void printFleetSummary(const std::vector<float>& busX, const std::vector<float>& busY) {
+	double checksum = 0.0;
+	for (size_t i = 0; i < busX.size(); ++i)
+		checksum += busX[i] + busY[i];
+	std::cout << "Kontrolna suma pozicija: " << checksum << std::endl;
+}
+
+// Vozni park sa fiksnim korakom, na svim jezgrima
+static int runFleetTicks(int argc, char** argv, const BusRoute& route, double hours, float dt, int buses) {
+	const char* threadsArg = findArg(argc, argv, "--threads");
+	ThreadPool pool(threadsArg ? atoi(threadsArg) : 0);
+	BusFleet fleet;
+	fleet.reset(buses, route);
+
+	long long steps = (long long)(hours * 3600.0 / dt);
+	auto start = std::chrono::steady_clock::now();
+	for (long long i = 0; i < steps; ++i)
+		updateFleetParallel(fleet, route, dt, pool);
+	double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << "Simulirano: " << hours << " h, " << buses << " autobusa, " << steps << " koraka (dt = " << dt
+		<< " s, " << fleetKernelIsaName(activeFleetKernelIsa()) << ", " << pool.threadCount() << " niti)" << std::endl;
+	printThroughput(hours, wallSeconds);
+	updateFleetPositions(fleet, route, 0, fleet.size());
+	printFleetSummary(fleet.busX, fleet.busY);
+	return 0;
+}
+
+// Vozni park vodjen dogadjajima; pozicije se racunaju samo u trenucima uzorkovanja
+static int runFleetEvents(int argc, char** argv, const BusRoute& route, double hours, int buses) {
+	const char* intervalArg = findArg(argc, argv, "--sample-interval");
+	double sampleInterval = intervalArg ? atof(intervalArg) : 0.0;
+	double endTime = hours * 3600.0;
+	EventDrivenFleet fleet;
+	fleet.reset(buses, route);
+
+	std::vector<float> busX, busY, doorAngle;
+	long long samples = 0;
+	auto start = std::chrono::steady_clock::now();
+	if (sampleInterval > 0.0) {
+		for (double t = sampleInterval; t <= endTime; t += sampleInterval) {
+			fleet.advanceTo(t);
+			fleet.sample(busX, busY, doorAngle);
+			samples++;
+		}
+	}
+	fleet.advanceTo(endTime);
+	fleet.sample(busX, busY, doorAngle);
+	double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << "Simulirano: " << hours << " h, " << buses << " autobusa, " << fleet.processedEvents
+		<< " dogadjaja, " << samples << " uzoraka" << std::endl;
+	printThroughput(hours, wallSeconds);
+	printFleetSummary(busX, busY);
+	return 0;
+}
+
+static int writeAtlas(int argc, char** argv) {
+	const char* name = findArg(argc, argv, "--write-atlas");
+	if (!name || !*name) {
+		std::cerr << "Upotreba: --write-atlas <ime>" << std::endl;
+		return -1;
+	}
+	AtlasImage atlas;
+	std::vector<AtlasRegion> regions;
+	if (!buildAtlas(SPRITE_FILES, SPRITE_COUNT, SPRITE_MAX_SIZE, ATLAS_PADDING, atlas, regions))
+		return -1;
+	std::string imagePath = std::string(name) + ".tga";
+	std::string tablePath = std::string(name) + ".txt";
+	if (!writeAtlasTga(imagePath.c_str(), atlas) || !writeAtlasTable(tablePath.c_str(), SPRITE_FILES, regions))
+		return -1;
+	std::cout << "Upisano: " << imagePath << " (" << atlas.width << "x" << atlas.height << ") i " << tablePath << std::endl;
+	return 0;
+}
+
+static int cookAssets(int argc, char** argv) {
+	const char* pathArg = findArg(argc, argv, "--cook-assets");
+	const char* filePath = *pathArg ? pathArg : COOKED_ATLAS_DEFAULT_PATH;
+	// Otisak pre citanja slika: ako se neka izmeni tokom kuvanja, atlas ce biti zastareo
+	uint64_t sourceHash = cookedAtlasSourceHash();
+	AtlasImage atlas;
+	std::vector<AtlasRegion> regions;
+	size_t sourceBytes = 0;
+	if (!buildAtlas(SPRITE_FILES, SPRITE_COUNT, SPRITE_MAX_SIZE, ATLAS_PADDING, atlas, regions, &sourceBytes))
+		return -1;
+	std::vector<AtlasImage> mips;
+	buildAtlasMips(atlas, ATLAS_MIP_LEVELS, mips);
+	if (!writeCookedAtlas(filePath, mips, regions, sourceHash))
+		return -1;
+
+	std::vector<AtlasLevel> levels;
+	for (const AtlasImage& mip : mips)
+		levels.push_back({ mip.width, mip.height, mip.pixels.data() });
+	const double MB = 1024.0 * 1024.0;
+	std::cout << "Upisano: " << filePath << " (" << atlas.width << "x" << atlas.height << ", " << mips.size() << " mip nivoa)" << std::endl;
+	std::cout << "Memorija tekstura: zasebne slike u punoj rezoluciji " << sourceBytes / MB
+		<< " MB -> atlas " << mipChainBytes(levels) / MB << " MB" << std::endl;
+	return 0;
+}
+
+int runHeadless(int argc, char** argv) {
+	if (findArg(argc, argv, "--cook-assets"))
+		return cookAssets(argc, argv);
+	if (findArg(argc, argv, "--write-route"))
+		return writeRoute(argc, argv);
+	if (findArg(argc, argv, "--write-atlas"))
+		return writeAtlas(argc, argv);
+	if (findArg(argc, argv, "--bench-fleet"))
+		return runFleetBenchmark(argc, argv);
+
+	double hours = atof(findArg(argc, argv, "--headless"));
+	const char* dtArg = findArg(argc, argv, "--dt");
+	float dt = dtArg ? (float)atof(dtArg) : 1.0f / 60.0f;
+	if (hours <= 0.0 || dt <= 0.0f) {
+		std::cerr << "Upotreba: --headless <sati> [--dt <sekunde>] [--buses <n>] [--threads <n>] [--event-driven [--sample-interval <s>]]" << std::endl;
+		return -1;
+	}
+
+	initRandomSeed(seedFromArgs(argc, argv));
+	BusRoute route;
+	if (!routeFromArgs(argc, argv, route))
+		return -1;
+	const char* busesArg = findArg(argc, argv, "--buses");
+	int buses = busesArg ? atoi(busesArg) : 0;
+	if (findArg(argc, argv, "--event-driven"))
+		return runFleetEvents(argc, argv, route, hours, std::max(buses, 1));
+	if (buses > 0)
+		return runFleetTicks(argc, argv, route, hours, dt, buses);
+
+	BusSimulation sim;
+	sim.reset(route);
+
+	long long steps = (long long)(hours * 3600.0 / dt);
+	auto start = std::chrono::steady_clock::now();
+	for (long long i = 0; i < steps; ++i)
+		sim.update(dt);
+	auto end = std::chrono::steady_clock::now();
+	double wallSeconds = std::chrono::duration<double>(end - start).count();
+
+	std::cout << "Simulirano: " << hours << " h u " << steps << " koraka (dt = " << dt << " s)" << std::endl;
+	std::cout << "Vreme izvrsavanja: " << wallSeconds << " s";
+	if (wallSeconds > 0.0)
+		std::cout << " | " << steps / wallSeconds << " koraka/s | " << hours * 3600.0 / wallSeconds << "x brze od realnog vremena";
+	std::cout << std::endl;
+	std::cout << "Predjenih deonica: " << sim.completedSegments << " | Trenutna stanica: " << sim.currentStationIndex << std::endl;
+	return 0;
+}
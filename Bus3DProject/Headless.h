@@ -0,0 +1,25 @@
+#pragma once
+#include <cstdint>
+
+// Pokretanje simulacije bez prozora i OpenGL konteksta:
+//   Bus3DProject --headless <sati> [--dt <sekunde>]            jedan autobus, fiksni korak
+//   Bus3DProject --headless <sati> --buses <n> [--threads <n>]  vozni park, fiksni korak
+//   Bus3DProject --headless <sati> --event-driven [--buses <n>] [--sample-interval <s>]
+//                                                              vozni park, skokovi sa dogadjaja na dogadjaj
+//   Bus3DProject --bench-fleet <broj autobusa> [--seconds <simulirano vreme>] [--threads <n>]
+//   Bus3DProject --write-route <fajl> [--stations <n>]             upisuje generisanu elipsu u fajl linije
+//   Bus3DProject --write-atlas <ime>                               pakuje res/ slike u <ime>.tga i tabelu <ime>.txt
+//   Bus3DProject --cook-assets [<fajl>]                            atlas sa mipovima, spreman za GPU (res/sprites.cooked)
+// Svi rezimi (i interaktivni) primaju --seed <n> za ponovljive voznje
+// i --route <fajl> [--line <n>] za liniju iz fajla umesto generisane elipse.
+bool isHeadlessRun(int argc, char** argv);
+int runHeadless(int argc, char** argv);
+
+// Vrednost argumenta posle imena ("" ako je poslednji), ili nullptr ako ga nema
+const char* findArg(int argc, char** argv, const char* name);
+// Seme iz --seed, ili iz trenutnog vremena ako ga nema
+uint64_t seedFromArgs(int argc, char** argv);
+
+struct BusRoute;
+// Linija iz --route fajla, ili generisana elipsa sa --stations stanica (podrazumevano 10)
+bool routeFromArgs(int argc, char** argv, BusRoute& route);
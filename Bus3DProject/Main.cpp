@@ -6,17 +6,38 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <cmath>
 #include <vector>
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <ctime>
+#include <functional>
 #include "Util.h"
-
-#define M_PI 3.14159265358979323846
+#include "BusSimulation.h"
+#include "Headless.h"
+#include "Random.h"
+#include "CameraBuffer.h"
+#include "RenderView.h"
+#include "SpriteBatch.h"
+#include "TextureAtlas.h"
+#include "CookedAtlas.h"
+#include "SpriteAtlasLoader.h"
+#include "TextureStreamer.h"
+#include "ShaderCompiler.h"
+#include "ColoredMesh.h"
+#include "RenderQueue.h"
 
 // --- POSTAVKE ---
 const unsigned int SCR_WIDTH = 1200;
 const unsigned int SCR_HEIGHT = 800;
 const unsigned int FBO_WIDTH = 800;
 const unsigned int FBO_HEIGHT = 600;
+// Mapa se crta samo kada se nesto na njoj promeni, i najvise ovoliko puta u sekundi
+const double MINIMAP_DEFAULT_RATE = 30.0;
+
+// Slanje tekstura: najvise 4 MB po frejmu, kroz 8 PBO slotova od po 1 MB
+const size_t TEXTURE_UPLOAD_BUDGET_BYTES = 4 << 20;
+const size_t TEXTURE_UPLOAD_SLOT_BYTES = 1 << 20;
+const int TEXTURE_UPLOAD_SLOTS = 8;
 
 // Kamera (Pozicija vozača)
 glm::vec3 cameraPos = glm::vec3(0.0f, 1.5f, 0.0f); // Vozač sedi na visini 1.5
@@ -31,31 +52,53 @@ float lastX = SCR_WIDTH / 2.0;
 float lastY = SCR_HEIGHT / 2.0;
 
 // --- 2D BUS SIMULATION VARIABLES ---
-unsigned busTexture;
-unsigned stationTexture;
-unsigned closedIconTexture;
-unsigned openIconTexture;
-unsigned controlIconTexture;
-unsigned imeTexture;
-unsigned int colorShader2D;
-unsigned int rectShader2D;
+// Sve 2D slike su delovi jedne teksture (TextureAtlas.h)
+unsigned atlasTexture;
+AtlasRegion spriteRegions[SPRITE_COUNT];
+ShaderProgram pathShader2D;
+int pathViewportLoc = -1;
+int pathHalfWidthLoc = -1;
+ShaderProgram rectShader2D;
 
 const float BUS_SCALE = 0.25f;
 const float STATION_SCALE = 0.15f;
-const float TRAVEL_TIME_SECONDS = 5.0f;
-const float STATION_WAIT_SECONDS = 10.0f;
-
-int currentStationIndex = 0;
-float currentSegmentTime = 0.0f;
-bool isWaiting = true;
-float waitTimer = 0.0f;
-int passengersNumber = 0;
-int punishmentNumber = 0;
-bool showControls = false;
+
+// Redosled crtanja u mapi (SpriteBatch sortira po sloju, pa po teksturi)
+const int SPRITE_LAYER_STATIONS = 0;
+const int SPRITE_LAYER_BUS = 1;
+const int SPRITE_LAYER_ICONS = 2;
+
+// Delovi kabine sa sopstvenom matricom modela (model[] u basic.vert)
+const int CABIN_PART_STATIC = 0;
+const int CABIN_PART_DOOR = 1;
+const int CABIN_PART_COUNT = 2;
+
+// Prolaz u kljucu RenderQueue-a; mapa se crta posebno, u svoj FBO
+const int RENDER_PASS_CABIN = 0;
+
+// Debljina putanje u pikselima mape pri FBO_HEIGHT; raste zajedno sa mapom
+const float PATH_WIDTH_PIXELS = 10.0f;
+
+// Prozor u stvarnoj velicini framebuffer-a; menja ga framebuffer_size_callback
+RenderView screenView;
+
+// Sve od cega zavisi slika mape; mapa se crta ponovo samo kada se ovo promeni
+struct MinimapContent {
+	float busX = 0.0f;
+	float busY = 0.0f;
+	SpriteId statusIcon = SPRITE_COUNT;
+	bool showControls = false;
+	unsigned int texture = 0;
+
+	bool operator==(const MinimapContent&) const = default;
+};
+
+// Taster R: slike se ponovo dekodiraju iz res/ i atlas se menja bez zastoja
+bool spriteReloadRequested = false;
+
+BusSimulation simulation;
+FixedTimestep timestep;
 double lastTime;
-float doorAngle = 0.0f;
-const float DOOR_OPEN_ANGLE = 90.0f;
-const float DOOR_ANIMATION_SPEED = 120.0f;
 
 // Funkcije (Prototipi)
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);
@@ -65,16 +108,77 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
 void mouse_button_callback(GLFWwindow* window, int button, int action, int mods);
 
 // --- 2D SIMULATION HELPER FUNCTIONS ---
-void preprocessTexture(unsigned& texture, const char* filepath) {
-	texture = loadImageToTexture(filepath);
-	if (texture != 0) {
-		glBindTexture(GL_TEXTURE_2D, texture);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-		glBindTexture(GL_TEXTURE_2D, 0);
+// Tekstura sa prostorom za sve mip nivoe; pikseli stizu kroz TextureStreamer
+unsigned int allocateAtlasTexture(const std::vector<AtlasLevel>& levels) {
+	unsigned int texture;
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (int)levels.size() - 1);
+	for (size_t i = 0; i < levels.size(); ++i)
+		glTexImage2D(GL_TEXTURE_2D, (int)i, GL_RGBA, levels[i].width, levels[i].height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	return texture;
+}
+
+// Siva tekstura 1x1 dok se atlas ne pripremi u pozadini
+unsigned int createPlaceholderTexture() {
+	const unsigned char grey[4] = { 200, 200, 200, 255 };
+	unsigned int texture;
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, grey);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	return texture;
+}
+
+// Koordinate teksture (u, v na pomeraju uvOffset) se preslikavaju na deo atlasa i upisuju u VBO
+void mapQuadToSprite(unsigned int VBO, const float* vertices, int vertexCount, int stride, int uvOffset, SpriteId sprite) {
+	const AtlasRegion& region = spriteRegions[sprite];
+	std::vector<float> mapped(vertices, vertices + vertexCount * stride);
+	for (int v = 0; v < vertexCount; ++v) {
+		float* uv = &mapped[v * stride + uvOffset];
+		uv[0] = region.u0 + uv[0] * (region.u1 - region.u0);
+		uv[1] = region.v0 + uv[1] * (region.v1 - region.v0);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, mapped.size() * sizeof(float), mapped.data());
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// Atlas iz SpriteAtlasLoader-a se salje kroz TextureStreamer tokom nekoliko frejmova.
+// Dotadasnja tekstura (privremena ili prethodni atlas) se crta dok ne stignu svi
+// nivoi, a onda se menja zajedno sa koordinatama slika i poziva se onSwap.
+// Poziva se kada je ready(); vraca false ako atlas nije napravljen.
+bool streamSpriteAtlas(SpriteAtlasLoader& loader, TextureStreamer& streamer, std::function<void()> onSwap) {
+	loader.finish();
+	if (!loader.succeeded) {
+		std::cerr << "GREŠKA: Nije moguće napraviti atlas tekstura!" << std::endl;
+		loader.release();
+		return false;
 	}
+	double uploadStart = glfwGetTime();
+	streamer.queue(allocateAtlasTexture(loader.levels), loader.levels, [&loader, uploadStart, onSwap](unsigned int texture) {
+		glDeleteTextures(1, &atlasTexture);
+		atlasTexture = texture;
+		std::copy(loader.regions, loader.regions + SPRITE_COUNT, spriteRegions);
+		std::cout << "Teksture: " << (loader.fromCooked ? "skuvan atlas" : "dekodirane slike iz res/") << " | priprema "
+			<< loader.seconds * 1000.0 << " ms u pozadini, slanje kroz PBO " << (glfwGetTime() - uploadStart) * 1000.0 << " ms | "
+			<< mipChainBytes(loader.levels) / (1024.0 * 1024.0) << " MB (" << loader.levels.size() << " mip nivoa)" << std::endl;
+		loader.release();
+		onSwap();
+	});
+	return true;
+}
+
+void addSprite(SpriteBatch& batch, SpriteId sprite, float x, float y, float scale, int layer) {
+	const AtlasRegion& region = spriteRegions[sprite];
+	batch.add(atlasTexture, x, y, scale, layer, region.u0, region.v0, region.u1, region.v1);
 }
 
 void formVAOTextured2D(float* vertices, size_t size, unsigned int& VAO) {
@@ -92,72 +196,172 @@ void formVAOTextured2D(float* vertices, size_t size, unsigned int& VAO) {
 	glBindVertexArray(0);
 }
 
-void formVAOPosition2D(std::vector<float> vertices, size_t size, unsigned int& VAO) {
+// Traka za path.vert: tacke zatvorene putanje, svaka dvaput, sa po jednim parom
+// ispred (poslednja tacka) i iza (druga tacka). Isti bafer je vezan tri puta,
+// sa pomerajem od jednog para, kao prethodna, trenutna i sledeca tacka.
+// Crta se 2 * (count + 1) temena kao GL_TRIANGLE_STRIP.
+void formVAOPathStrip(const RoutePath& path, unsigned int& VAO) {
+	int count = path.numSegments();
+	std::vector<float> strip;
+	strip.reserve(4 * (count + 3));
+	auto addPoint = [&](int k) {
+		for (int copy = 0; copy < 2; ++copy) {
+			strip.push_back(path.points[2 * k]);
+			strip.push_back(path.points[2 * k + 1]);
+		}
+	};
+	addPoint(count - 1);
+	for (int k = 0; k <= count; ++k)
+		addPoint(k);
+	addPoint(1 % count);
+
 	unsigned int VBO;
 	glGenVertexArrays(1, &VAO);
 	glGenBuffers(1, &VBO);
 	glBindVertexArray(VAO);
 	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, size, vertices.data(), GL_STATIC_DRAW);
-	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-	glEnableVertexAttribArray(0);
+	glBufferData(GL_ARRAY_BUFFER, strip.size() * sizeof(float), strip.data(), GL_STATIC_DRAW);
+	const size_t pairBytes = 4 * sizeof(float);
+	for (int attribute = 0; attribute < 3; ++attribute) {
+		glVertexAttribPointer(attribute, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)(attribute * pairBytes));
+		glEnableVertexAttribArray(attribute);
+	}
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 	glBindVertexArray(0);
 }
 
-float randomOffset(float range) {
-	return (float(rand()) / RAND_MAX * 2.0f - 1.0f) * range;
-}
-
-void drawPath(unsigned int shader, unsigned int VAO, int numPoints) {
-	glUseProgram(shader);
-	glUniform4f(glGetUniformLocation(shader, "uColor"), 1.0f, 0.0f, 0.0f, 1.0f);
-	glUniform2f(glGetUniformLocation(shader, "uPosOffset"), 0.0f, 0.0f);
-	glLineWidth(10.0f);
+// Boja i pomeraj putanje se postavljaju jednom, pri ucitavanju pathShader2D;
+// debljina se zadaje u pikselima cilja, pa je ista na svakom drajveru
+void drawPath(const ShaderProgram& shader, unsigned int VAO, int numPoints, const RenderTarget& target) {
+	shader.use();
+	shader.setVec2(pathViewportLoc, glm::vec2((float)target.width, (float)target.height));
+	shader.setFloat(pathHalfWidthLoc, 0.5f * PATH_WIDTH_PIXELS * target.height / FBO_HEIGHT);
 	glBindVertexArray(VAO);
-	glDrawArrays(GL_LINE_LOOP, 0, numPoints);
+	glDrawArrays(GL_TRIANGLE_STRIP, 0, 2 * (numPoints + 1));
 	glBindVertexArray(0);
 }
 
-void drawStations2D(unsigned int shader, unsigned int VAO, float* positions, int num) {
-	glUseProgram(shader);
+// Stari nacin, tri uniforme trazene po imenu i jedan poziv po stanici (rectloop.vert);
+// ostavljen samo za poredjenje (--bench-stations)
+void drawStationsLoop2D(const ShaderProgram& shader, unsigned int VAO, const float* positions, int num) {
+	shader.use();
 	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, stationTexture);
+	glBindTexture(GL_TEXTURE_2D, atlasTexture);
 	glBindVertexArray(VAO);
+	const AtlasRegion& region = spriteRegions[SPRITE_STATION];
+	glUniform4f(glGetUniformLocation(shader.id(), "uUvRect"), region.u0, region.v0, region.u1, region.v1);
 	for (int i = 0; i < num; ++i) {
-		glUniform1f(glGetUniformLocation(shader, "uX"), positions[2 * i]);
-		glUniform1f(glGetUniformLocation(shader, "uY"), positions[2 * i + 1]);
-		glUniform1f(glGetUniformLocation(shader, "uS"), STATION_SCALE);
+		glUniform1f(glGetUniformLocation(shader.id(), "uX"), positions[2 * i]);
+		glUniform1f(glGetUniformLocation(shader.id(), "uY"), positions[2 * i + 1]);
+		glUniform1f(glGetUniformLocation(shader.id(), "uS"), STATION_SCALE);
 		glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
 	}
 	glBindVertexArray(0);
 }
 
-void drawBus2D(unsigned int shader, unsigned int VAO, float x, float y) {
-	glUseProgram(shader);
-	glUniform1f(glGetUniformLocation(shader, "uX"), x);
-	glUniform1f(glGetUniformLocation(shader, "uY"), y);
-	glUniform1f(glGetUniformLocation(shader, "uS"), BUS_SCALE);
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, busTexture);
-	glBindVertexArray(VAO);
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-	glBindVertexArray(0);
+// Vreme frejma u FBO-u za petlju po stanici i za SpriteBatch (--bench-stations)
+void benchmarkStations2D(const RenderTarget& target, SpriteBatch& batch, float* quadVertices, size_t quadSize) {
+	const int stationCounts[] = { 10, 1000, 100000 };
+	const int FRAMES = 30;
+	ShaderProgram loopShader = createShader(readFile("rectloop.vert").c_str(), readFile("rect.frag").c_str());
+	loopShader.use();
+	loopShader.setInt(loopShader.uniform("uTex0"), 0);
+	target.bind();
+	glDisable(GL_DEPTH_TEST);
+
+	for (int num : stationCounts) {
+		BusRoute route = createEllipseRoute(num, 0.8f, 0.5f, 1, 0.0f);
+		unsigned int VAOloop;
+		formVAOTextured2D(quadVertices, quadSize, VAOloop);
+
+		double frameMs[2];
+		for (int batched = 0; batched < 2; ++batched) {
+			double start = 0.0;
+			// Prvi frejm je zagrevanje drajvera i ne ulazi u merenje
+			for (int frame = 0; frame <= FRAMES; ++frame) {
+				if (frame == 1) start = glfwGetTime();
+				glClear(GL_COLOR_BUFFER_BIT);
+				if (batched) {
+					for (int i = 0; i < num; ++i)
+						addSprite(batch, SPRITE_STATION, route.stationPositions[2 * i], route.stationPositions[2 * i + 1], STATION_SCALE, SPRITE_LAYER_STATIONS);
+					batch.flush(rectShader2D);
+				}
+				else {
+					drawStationsLoop2D(loopShader, VAOloop, route.stationPositions, num);
+				}
+				glFinish();
+			}
+			frameMs[batched] = (glfwGetTime() - start) * 1000.0 / FRAMES;
+		}
+		std::cout << "Stanica: " << num << " | petlja: " << frameMs[0] << " ms/frejm | SpriteBatch: "
+			<< frameMs[1] << " ms/frejm | ubrzanje " << frameMs[0] / frameMs[1] << "x" << std::endl;
+
+		glDeleteVertexArrays(1, &VAOloop);
+	}
+	glDeleteProgram(loopShader.id());
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
-void drawIcon2D(unsigned int shader, unsigned int VAO, unsigned int tex, float x, float y, float scale) {
-	glUseProgram(shader);
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, tex);
-	glUniform1f(glGetUniformLocation(shader, "uX"), x);
-	glUniform1f(glGetUniformLocation(shader, "uY"), y);
-	glUniform1f(glGetUniformLocation(shader, "uS"), scale);
-	glBindVertexArray(VAO);
-	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-	glBindVertexArray(0);
+// CPU vreme postavljanja uniformi za jedan frejm: ista azuriranja za trenutne
+// sejdere (UBO kamere, model[2] kabine, model i screenTexture za tablu i sliku),
+// jednom sa trazenjem lokacija po imenu, a jednom sa lokacijama procitanim
+// pri linkovanju (--bench-uniforms)
+void benchmarkUniforms(const ShaderProgram& cabin, const ShaderProgram& textured, CameraBuffer& camera) {
+	const int FRAMES = 10000;
+	// Kontrolna tabla i slika
+	const int TEXTURED_PARTS = 2;
+	glm::mat4 matrix = glm::mat4(1.0f);
+	unsigned int cabinId = cabin.id();
+	unsigned int texturedId = textured.id();
+	const glm::mat4 cabinModels[CABIN_PART_COUNT] = { matrix, matrix };
+
+	double start = glfwGetTime();
+	for (int frame = 0; frame < FRAMES; ++frame) {
+		camera.update(matrix, matrix);
+		glUseProgram(cabinId);
+		glUniformMatrix4fv(glGetUniformLocation(cabinId, "model"), CABIN_PART_COUNT, GL_FALSE, glm::value_ptr(cabinModels[0]));
+		glUseProgram(texturedId);
+		for (int part = 0; part < TEXTURED_PARTS; ++part) {
+			glUniformMatrix4fv(glGetUniformLocation(texturedId, "model"), 1, GL_FALSE, glm::value_ptr(matrix));
+			glUniform1i(glGetUniformLocation(texturedId, "screenTexture"), 0);
+		}
+	}
+	glFinish();
+	double byNameUs = (glfwGetTime() - start) * 1e6 / FRAMES;
+
+	const int modelLoc = cabin.uniform("model");
+	const int texturedModelLoc = textured.uniform("model");
+	const int screenTextureLoc = textured.uniform("screenTexture");
+
+	start = glfwGetTime();
+	for (int frame = 0; frame < FRAMES; ++frame) {
+		camera.update(matrix, matrix);
+		cabin.use();
+		cabin.setMat4Array(modelLoc, cabinModels, CABIN_PART_COUNT);
+		textured.use();
+		for (int part = 0; part < TEXTURED_PARTS; ++part) {
+			textured.setMat4(texturedModelLoc, matrix);
+			textured.setInt(screenTextureLoc, 0);
+		}
+	}
+	glFinish();
+	double cachedUs = (glfwGetTime() - start) * 1e6 / FRAMES;
+
+	std::cout << "Uniforme po imenu: " << byNameUs << " us/frejm | kes lokacija: " << cachedUs
+		<< " us/frejm | ubrzanje " << byNameUs / cachedUs << "x" << std::endl;
 }
 
-int main() {
+int main(int argc, char** argv) {
+	if (isHeadlessRun(argc, argv))
+		return runHeadless(argc, argv);
+	auto processStart = std::chrono::steady_clock::now();
+	auto secondsSinceStart = [&]() { return std::chrono::duration<double>(std::chrono::steady_clock::now() - processStart).count(); };
+
+	// Slike se pripremaju u pozadini dok se pravi prozor i kompajliraju sejderi
+	SpriteAtlasLoader spriteLoader;
+	const char* assetsArg = findArg(argc, argv, "--assets");
+	spriteLoader.start(assetsArg && *assetsArg ? assetsArg : COOKED_ATLAS_DEFAULT_PATH);
+
 	// 1. Inicijalizacija GLFW
 	if (!glfwInit()) {
 		std::cerr << "Greška pri inicijalizaciji GLFW!" << std::endl;
@@ -176,6 +380,9 @@ int main() {
 		return -1;
 	}
 	glfwMakeContextCurrent(window);
+	int framebufferWidth, framebufferHeight;
+	glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+	screenView.resize(framebufferWidth, framebufferHeight);
 
 	// 3. Callback funkcije i miš
 	glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
@@ -196,99 +403,79 @@ int main() {
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-	srand(time(NULL));
-	lastTime = glfwGetTime();
-
-	// === LOAD 3D SHADERS ===
-	std::string vSourceStr = readFile("basic.vert");
-	std::string fSourceStr = readFile("basic.frag");
-	unsigned int shaderProgram = createShader(vSourceStr.c_str(), fSourceStr.c_str());
-
-	std::string vTexSourceStr = readFile("texture.vert");
-	std::string fTexSourceStr = readFile("texture.frag");
-	unsigned int textureShader = createShader(vTexSourceStr.c_str(), fTexSourceStr.c_str());
-
-	// === LOAD 2D SHADERS FOR FRAMEBUFFER ===
-	std::string vRect = readFile("rect.vert");
-	std::string fRect = readFile("rect.frag");
-	rectShader2D = createShader(vRect.c_str(), fRect.c_str());
-	glUseProgram(rectShader2D);
-	glUniform1i(glGetUniformLocation(rectShader2D, "uTex0"), 0);
-
-	std::string vColor = readFile("color.vert");
-	std::string fColor = readFile("color.frag");
-	colorShader2D = createShader(vColor.c_str(), fColor.c_str());
+	initRandomSeed(seedFromArgs(argc, argv));
+
+	// Simulacija ide fiksnim korakom: --tick-rate <Hz>, --max-catch-up <broj koraka>
+	if (const char* tickRate = findArg(argc, argv, "--tick-rate"))
+		if (atof(tickRate) > 0.0) timestep.tickSeconds = (float)(1.0 / atof(tickRate));
+	if (const char* maxCatchUp = findArg(argc, argv, "--max-catch-up"))
+		if (atoi(maxCatchUp) > 0) timestep.maxCatchUpTicks = atoi(maxCatchUp);
+
+	// === LOAD SHADERS ===
+	// Svi programi se predaju drajveru odmah i kompajliraju se dok traje ostatak
+	// inicijalizacije; statusi i logovi se citaju tek pre prvog crtanja (ShaderCompiler.h).
+	// Linkovani programi se cuvaju u shader_cache/; --no-shader-cache uvek kompajlira
+	double shaderStart = glfwGetTime();
+	ProgramCache programCache;
+	if (!findArg(argc, argv, "--no-shader-cache") && !programCache.open(PROGRAM_CACHE_DEFAULT_DIR))
+		std::cout << "Kes sejdera nije dostupan, programi se kompajliraju" << std::endl;
+	ShaderCompiler shaderCompiler;
+	shaderCompiler.begin(&programCache);
+	ShaderProgram shaderProgram;
+	ShaderProgram textureShader;
+	shaderCompiler.submit("basic", readFile("basic.vert"), readFile("basic.frag"), &shaderProgram);
+	shaderCompiler.submit("texture", readFile("texture.vert"), readFile("texture.frag"), &textureShader);
+	shaderCompiler.submit("rect", readFile("rect.vert"), readFile("rect.frag"), &rectShader2D);
+	shaderCompiler.submit("path", readFile("path.vert"), readFile("color.frag"), &pathShader2D);
+	double shaderSubmitSeconds = glfwGetTime() - shaderStart;
 
 	// === LOAD TEXTURES FOR 2D SIMULATION ===
-	preprocessTexture(busTexture, "res/avtobus.png");
-	preprocessTexture(stationTexture, "res/busstation.jpeg");
-	preprocessTexture(closedIconTexture, "res/zatvorena.png");
-	preprocessTexture(openIconTexture, "res/otvorena.png");
-	preprocessTexture(controlIconTexture, "res/kontrola.png");
-	preprocessTexture(imeTexture, "res/ime.png");
-	if (imeTexture == 0) {
-		std::cerr << "GREŠKA: Nije moguće učitati res/ime.png!" << std::endl;
-	}
+	// Do zavrsetka spriteLoader-a sve 2D slike su sive
+	atlasTexture = createPlaceholderTexture();
+	TextureStreamer textureStreamer;
+	textureStreamer.create(TEXTURE_UPLOAD_SLOT_BYTES, TEXTURE_UPLOAD_SLOTS);
 
 	// === SETUP 2D SIMULATION DATA ===
-	const int NUM_STATIONS = 10;
-	float verticesBus2D[] = { -0.5f, 0.5f, 0.0f, 1.0f, -0.5f, -0.5f, 0.0f, 0.0f, 0.5f, -0.5f, 1.0f, 0.0f, 0.5f, 0.5f, 1.0f, 1.0f };
 	float verticesStation2D[] = { -0.5f, 0.5f, 0.0f, 1.0f, -0.5f, -0.5f, 0.0f, 0.0f, 0.5f, -0.5f, 1.0f, 0.0f, 0.5f, 0.5f, 1.0f, 1.0f };
 
-	float stationPositions[NUM_STATIONS * 2];
-	float a = 0.8f;
-	float b = 0.5f;
-	for (int i = 0; i < NUM_STATIONS; ++i) {
-		float angle = i * 2 * M_PI / NUM_STATIONS;
-		stationPositions[2 * i] = cos(angle) * a;
-		stationPositions[2 * i + 1] = sin(angle) * b;
-	}
-
-	std::vector<float> pathVertices;
-	const int CURVE_POINTS_PER_SEGMENT = 5;
-	const float WIGGLE_RANGE = 0.08f;
-	for (int i = 0; i < NUM_STATIONS; ++i) {
-		float x1 = stationPositions[2 * i];
-		float y1 = stationPositions[2 * i + 1];
-		float x2 = stationPositions[2 * ((i + 1) % NUM_STATIONS)];
-		float y2 = stationPositions[2 * ((i + 1) % NUM_STATIONS) + 1];
-		pathVertices.push_back(x1);
-		pathVertices.push_back(y1);
-		for (int j = 1; j < CURVE_POINTS_PER_SEGMENT; ++j) {
-			float t = (float)j / CURVE_POINTS_PER_SEGMENT;
-			float interX = x1 * (1.0f - t) + x2 * t;
-			float interY = y1 * (1.0f - t) + y2 * t;
-			float wiggleFactor = sin(t * M_PI);
-			pathVertices.push_back(interX + randomOffset(WIGGLE_RANGE * wiggleFactor));
-			pathVertices.push_back(interY + randomOffset(WIGGLE_RANGE * wiggleFactor));
-		}
+	BusRoute route;
+	if (!routeFromArgs(argc, argv, route)) {
+		glfwTerminate();
+		return -1;
 	}
+	simulation.reset(route);
+	BusRenderState previousState = simulation.renderState();
 
-	unsigned int VAObus2D, VAOstation2D, VAOpath2D;
-	formVAOTextured2D(verticesBus2D, sizeof(verticesBus2D), VAObus2D);
-	formVAOTextured2D(verticesStation2D, sizeof(verticesStation2D), VAOstation2D);
-	formVAOPosition2D(pathVertices, pathVertices.size() * sizeof(float), VAOpath2D);
-	int totalPathPoints = pathVertices.size() / 2;
-
-	float busX = stationPositions[0];
-	float busY = stationPositions[1];
+	// Stanice, autobus i ikonice idu kroz jedan SpriteBatch
+	SpriteBatch sprites;
+	sprites.create();
+	unsigned int VAOpath2D;
+	// Putanja se crta kao traka trouglova iz staticnog bafera, jednom za celu liniju
+	int totalPathPoints = route.path.numSegments();
+	formVAOPathStrip(route.path, VAOpath2D);
 
 	// === CREATE FRAMEBUFFER FOR 2D DISPLAY ===
-	unsigned int framebuffer;
-	glGenFramebuffers(1, &framebuffer);
-	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
-
-	unsigned int textureColorbuffer;
-	glGenTextures(1, &textureColorbuffer);
-	glBindTexture(GL_TEXTURE_2D, textureColorbuffer);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, FBO_WIDTH, FBO_HEIGHT, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, textureColorbuffer, 0);
-
-	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
-		std::cout << "ERROR::FRAMEBUFFER:: Framebuffer is not complete!" << std::endl;
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	// Rezolucija mape prati visinu ekrana (FBO_WIDTH x FBO_HEIGHT pri SCR_HEIGHT),
+	// a tekstura se realocira tek u sledecem frejmu posle promene velicine prozora
+	RenderTarget minimap;
+	minimap.create(FBO_WIDTH, FBO_HEIGHT);
+	unsigned int minimapGeneration = 0;
+	// Staticni sloj mape (putanja i stanice) se crta jednom u svoj FBO i pri svakom
+	// crtanju mape samo kopira; ponovo se pravi kada se promeni velicina, atlas ili linija
+	RenderTarget minimapBackground;
+	minimapBackground.create(FBO_WIDTH, FBO_HEIGHT);
+	bool backgroundDirty = true;
+	unsigned int backgroundAtlas = 0;
+	long long backgroundRedraws = 0;
+	// --minimap-rate <Hz>: najveca ucestanost osvezavanja mape, 0 = bez ogranicenja
+	RefreshLimiter minimapRefresh;
+	double minimapRate = MINIMAP_DEFAULT_RATE;
+	if (const char* rate = findArg(argc, argv, "--minimap-rate"))
+		minimapRate = atof(rate);
+	minimapRefresh.minInterval = minimapRate > 0.0 ? 1.0 / minimapRate : 0.0;
+	MinimapContent minimapContent;
+	long long minimapRedraws = 0;
+	long long frames = 0;
 
 	// === SETUP 3D CABIN ===
 	float vertices[] = {
@@ -328,41 +515,28 @@ int main() {
 		 1.0f, 2.5f, -4.99f,  1.0f, 1.0f   // Top right
 	};
 
-	unsigned int indices[] = {
-		0, 1, 2, 2, 3, 0,          // Pod
-		4, 5, 6, 6, 7, 4,          // Plafon
-		8, 9, 10, 10, 11, 8,       // Levi zid
-		12, 13, 14, 14, 15, 12,    // Desni zid
-		16, 17, 18, 18, 19, 16     // Šoferšajbna
-	};
-
 	unsigned int controlIndices[] = {
 		0, 1, 2, 2, 3, 0           // Kontrolna tabla
 	};
 
-	unsigned int doorIndices[] = {
-		0, 1, 2, 2, 3, 0           // Door
-	};
-
 	unsigned int imageIndices[] = {
 		0, 1, 2, 2, 3, 0           // Image quad
 	};
 
-	// VAO for cabin
-	unsigned int VAO, VBO, EBO;
-	glGenVertexArrays(1, &VAO);
-	glGenBuffers(1, &VBO);
-	glGenBuffers(1, &EBO);
-
-	glBindVertexArray(VAO);
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-	glEnableVertexAttribArray(0);
+	// Kabina i vrata u jednom baferu, boja i providnost su u temenima:
+	// sve neprovidne povrsi se crtaju jednim pozivom, a providne jos jednim
+	MeshBuilder cabinBuilder;
+	cabinBuilder.addQuad(&vertices[0 * 3], glm::vec3(0.0f, 0.0f, 0.0f), 1.0f, CABIN_PART_STATIC);  // Pod
+	cabinBuilder.addQuad(&vertices[4 * 3], glm::vec3(0.0f, 0.0f, 0.0f), 1.0f, CABIN_PART_STATIC);  // Plafon
+	cabinBuilder.addQuad(&vertices[8 * 3], glm::vec3(0.2f, 0.2f, 0.2f), 0.8f, CABIN_PART_STATIC);  // Levi zid
+	cabinBuilder.addQuad(&vertices[12 * 3], glm::vec3(0.2f, 0.2f, 0.2f), 0.8f, CABIN_PART_STATIC); // Desni zid
+	cabinBuilder.addQuad(&vertices[16 * 3], glm::vec3(0.0f, 0.3f, 0.5f), 0.3f, CABIN_PART_STATIC); // Šoferšajbna
+	cabinBuilder.addQuad(doorVertices, glm::vec3(0.4f, 0.2f, 0.0f), 1.0f, CABIN_PART_DOOR);
+	ColoredMesh cabinMesh;
+	cabinMesh.create(cabinBuilder);
+	// Centri teksturisanih povrsina, za sortiranje po dubini
+	const glm::vec3 controlCenter(0.0f, 0.6f, -4.0f);
+	const glm::vec3 imageCenter(0.0f, 2.0f, -4.99f);
 
 	// VAO for control panel (with texture coordinates)
 	unsigned int VAOcontrol, VBOcontrol, EBOcontrol;
@@ -382,22 +556,6 @@ int main() {
 	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
 	glEnableVertexAttribArray(1);
 
-	// VAO for door
-	unsigned int VAOdoor, VBOdoor, EBOdoor;
-	glGenVertexArrays(1, &VAOdoor);
-	glGenBuffers(1, &VBOdoor);
-	glGenBuffers(1, &EBOdoor);
-
-	glBindVertexArray(VAOdoor);
-	glBindBuffer(GL_ARRAY_BUFFER, VBOdoor);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(doorVertices), doorVertices, GL_STATIC_DRAW);
-
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBOdoor);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(doorIndices), doorIndices, GL_STATIC_DRAW);
-
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-	glEnableVertexAttribArray(0);
-
 	// VAO for image (with texture coordinates)
 	unsigned int VAOimage, VBOimage, EBOimage;
 	glGenVertexArrays(1, &VAOimage);
@@ -418,166 +576,220 @@ int main() {
 
 	glBindVertexArray(0);
 
+	// === SHADER RESULTS ===
+	// Sa parallel_shader_compile: da li je drajver zavrsio sve dok je trajala ostala inicijalizacija
+	bool compiledInBackground = shaderCompiler.parallel() && shaderCompiler.ready();
+	double waitStart = glfwGetTime();
+	if (!shaderCompiler.finish()) {
+		std::cerr << "GREŠKA: Sejderi nisu ispravni, pogledaj poruke iznad." << std::endl;
+		glfwTerminate();
+		return -1;
+	}
+	std::cout << "Sejderi: " << shaderCompiler.hits << " iz kesa, " << shaderCompiler.misses << " kompajlirano"
+		<< (compiledInBackground ? " u pozadini" : shaderCompiler.parallel() ? " paralelno" : "") << " | predaja " << shaderSubmitSeconds * 1000.0 << " ms, cekanje "
+		<< (glfwGetTime() - waitStart) * 1000.0 << " ms posle ostale inicijalizacije" << std::endl;
+
+	textureShader.use();
+	textureShader.setInt(textureShader.uniform("screenTexture"), 0);
+	rectShader2D.use();
+	rectShader2D.setInt(rectShader2D.uniform("uTex0"), 0);
+	pathShader2D.use();
+	pathShader2D.setVec4(pathShader2D.uniform("uColor"), glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+	pathShader2D.setVec2(pathShader2D.uniform("uPosOffset"), glm::vec2(0.0f, 0.0f));
+	pathViewportLoc = pathShader2D.uniform("uViewport");
+	pathHalfWidthLoc = pathShader2D.uniform("uHalfWidth");
+
+	// Lokacije uniformi 3D kabine, citaju se jednom umesto u svakom frejmu
+	const int cabinModelLoc = shaderProgram.uniform("model");
+	const int textureModelLoc = textureShader.uniform("model");
+
+	// Projekcija i pogled su u zajednickom uniform bufferu, salju se jednom po frejmu
+	CameraBuffer camera;
+	camera.create();
+	CameraBuffer::attach(shaderProgram);
+	CameraBuffer::attach(textureShader);
+
+	if (findArg(argc, argv, "--bench-uniforms")) {
+		benchmarkUniforms(shaderProgram, textureShader, camera);
+		glfwTerminate();
+		return 0;
+	}
+	if (findArg(argc, argv, "--bench-stations")) {
+		benchmarkStations2D(minimap, sprites, verticesStation2D, sizeof(verticesStation2D));
+		glfwTerminate();
+		return 0;
+	}
+
+	RenderQueue renderQueue;
+	renderQueue.setFarPlane(screenView.farPlane);
+	long long queueDraws = 0;
+	long long queueProgramChanges = 0;
+
 	// --- RENDER PETLJA ---
+	lastTime = glfwGetTime();
+	bool atlasLoading = true;
+	bool firstAtlas = true;
+	bool firstFrame = true;
+	auto onAtlasSwap = [&]() {
+		mapQuadToSprite(VBOimage, imageVertices, 4, 5, 3, SPRITE_IME);
+		if (firstAtlas)
+			std::cout << "Atlas spreman " << secondsSinceStart() * 1000.0 << " ms od pokretanja" << std::endl;
+		firstAtlas = false;
+	};
 	while (!glfwWindowShouldClose(window)) {
 		processInput(window);
 
+		if (spriteReloadRequested && !atlasLoading && !textureStreamer.busy()) {
+			std::cout << "Ponovno ucitavanje slika iz res/..." << std::endl;
+			spriteLoader.start(nullptr);
+			atlasLoading = true;
+			spriteReloadRequested = false;
+		}
+		if (atlasLoading && spriteLoader.ready()) {
+			streamSpriteAtlas(spriteLoader, textureStreamer, onAtlasSwap);
+			atlasLoading = false;
+		}
+		textureStreamer.update(TEXTURE_UPLOAD_BUDGET_BYTES);
+
 		// === UPDATE 2D SIMULATION LOGIC ===
 		double currentTime = glfwGetTime();
-		float deltaTime = (float)(currentTime - lastTime);
+		int ticks = timestep.advance(currentTime - lastTime);
 		lastTime = currentTime;
 
-		// Update door animation
-		if (isWaiting) {
-			if (doorAngle < DOOR_OPEN_ANGLE) {
-				doorAngle += DOOR_ANIMATION_SPEED * deltaTime;
-				if (doorAngle > DOOR_OPEN_ANGLE) doorAngle = DOOR_OPEN_ANGLE;
-			}
-		}
-		else {
-			if (doorAngle > 0.0f) {
-				doorAngle -= DOOR_ANIMATION_SPEED * deltaTime;
-				if (doorAngle < 0.0f) doorAngle = 0.0f;
-			}
+		for (int i = 0; i < ticks; ++i) {
+			previousState = simulation.renderState();
+			simulation.update(timestep.tickSeconds);
 		}
+		BusRenderState drawn = interpolateRenderState(previousState, simulation.renderState(), timestep.alpha());
 
-		if (isWaiting) {
-			waitTimer += deltaTime;
-			if (waitTimer >= STATION_WAIT_SECONDS) {
-				isWaiting = false;
-				currentSegmentTime = 0.0f;
-				waitTimer = 0.0f;
-				currentStationIndex = (currentStationIndex + 1) % NUM_STATIONS;
+		// === RENDER TO FRAMEBUFFER (2D SIMULATION) ===
+		if (minimapGeneration != screenView.generation) {
+			float scale = (float)screenView.height / SCR_HEIGHT;
+			if (minimap.resize((int)(FBO_WIDTH * scale), (int)(FBO_HEIGHT * scale))) {
+				minimapBackground.resize(minimap.width, minimap.height);
+				backgroundDirty = true;
+				minimapRefresh.force();
 			}
+			minimapGeneration = screenView.generation;
 		}
-		else {
-			currentSegmentTime += deltaTime;
-			float t = currentSegmentTime / TRAVEL_TIME_SECONDS;
-			if (t >= 1.0f) {
-				if (showControls) {
-					passengersNumber -= punishmentNumber + 1;
-					std::cout << "Kazna: " << punishmentNumber << " | Preostali putnici: " << passengersNumber << std::endl;
-					showControls = false;
-					punishmentNumber = 0;
-				}
-				t = 1.0f;
-				isWaiting = true;
+		// Dok autobus stoji na stanici mapa se ne menja i kabina koristi poslednju sliku
+		MinimapContent content;
+		content.busX = drawn.busX;
+		content.busY = drawn.busY;
+		content.statusIcon = simulation.isWaiting ? SPRITE_DOOR_OPEN : SPRITE_DOOR_CLOSED;
+		content.showControls = simulation.showControls;
+		content.texture = atlasTexture;
+		if (content != minimapContent)
+			minimapRefresh.invalidate();
+
+		if (minimapRefresh.shouldRefresh(currentTime)) {
+			minimapContent = content;
+			minimapRedraws++;
+			glDisable(GL_DEPTH_TEST);
+			if (backgroundDirty || backgroundAtlas != atlasTexture) {
+				minimapBackground.bind();
+				glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+				glClear(GL_COLOR_BUFFER_BIT);
+				drawPath(pathShader2D, VAOpath2D, totalPathPoints, minimapBackground);
+				for (int i = 0; i < route.numStations; ++i)
+					addSprite(sprites, SPRITE_STATION, route.stationPositions[2 * i], route.stationPositions[2 * i + 1], STATION_SCALE, SPRITE_LAYER_STATIONS);
+				sprites.flush(rectShader2D);
+				backgroundAtlas = atlasTexture;
+				backgroundDirty = false;
+				backgroundRedraws++;
 			}
-			int startIdx = ((currentStationIndex - 1 + NUM_STATIONS) % NUM_STATIONS) * 2;
-			float xA = stationPositions[startIdx];
-			float yA = stationPositions[startIdx + 1];
-			int endIdx = currentStationIndex * 2;
-			float xB = stationPositions[endIdx];
-			float yB = stationPositions[endIdx + 1];
-			busX = xA * (1.0f - t) + xB * t;
-			busY = yA * (1.0f - t) + yB * t;
-		}
-
-		// === RENDER TO FRAMEBUFFER (2D SIMULATION) ===
-		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
-		glViewport(0, 0, FBO_WIDTH, FBO_HEIGHT);
-		glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT);
-		glDisable(GL_DEPTH_TEST);
-
-		drawPath(colorShader2D, VAOpath2D, totalPathPoints);
-		drawStations2D(rectShader2D, VAOstation2D, stationPositions, NUM_STATIONS);
-		drawBus2D(rectShader2D, VAObus2D, busX, busY);
 
-		unsigned int statusTex = isWaiting ? openIconTexture : closedIconTexture;
-		drawIcon2D(rectShader2D, VAObus2D, statusTex, 0.75f, 0.85f, 0.2f);
+			// Kopija pozadine, pa samo autobus i ikonice; cena ne zavisi od broja stanica
+			minimapBackground.copyTo(minimap);
+			addSprite(sprites, SPRITE_BUS, content.busX, content.busY, BUS_SCALE, SPRITE_LAYER_BUS);
+			addSprite(sprites, content.statusIcon, 0.75f, 0.85f, 0.2f, SPRITE_LAYER_ICONS);
 
-		if (showControls) {
-			drawIcon2D(rectShader2D, VAObus2D, controlIconTexture, -0.75f, 0.85f, 0.3f);
+			if (content.showControls) {
+				addSprite(sprites, SPRITE_CONTROL, -0.75f, 0.85f, 0.3f, SPRITE_LAYER_ICONS);
+			}
+			sprites.flush(rectShader2D);
 		}
 
 		// === RENDER TO SCREEN (3D CABIN) ===
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
-		glViewport(0, 0, SCR_WIDTH, SCR_HEIGHT);
+		screenView.bind();
 		glEnable(GL_DEPTH_TEST);
 		glClearColor(0.5f, 0.8f, 0.9f, 1.0f);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-		glm::mat4 projection = glm::perspective(glm::radians(45.0f), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+		const glm::mat4& projection = screenView.projection;
 		glm::mat4 view = glm::lookAt(cameraPos, cameraPos + cameraFront, cameraUp);
 		glm::mat4 model = glm::mat4(1.0f);
+		camera.update(projection, view);
 
-		// Draw cabin with basic shader
-		glUseProgram(shaderProgram);
-		int colorLoc = glGetUniformLocation(shaderProgram, "color");
-		int alphaLoc = glGetUniformLocation(shaderProgram, "alpha");
-		glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-		glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "view"), 1, GL_FALSE, glm::value_ptr(view));
-		glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "model"), 1, GL_FALSE, glm::value_ptr(model));
-
-		glBindVertexArray(VAO);
-		glUniform3f(colorLoc, 0.0f, 0.0f, 0.0f);
-		glUniform1f(alphaLoc, 1.0f);
-		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-
-		glUniform3f(colorLoc, 0.0f, 0.0f, 0.0f);
-		glUniform1f(alphaLoc, 1.0f);
-		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, (void*)(6 * sizeof(unsigned int)));
-
-		glUniform3f(colorLoc, 0.2f, 0.2f, 0.2f);
-		glUniform1f(alphaLoc, 0.8f);
-		glDrawElements(GL_TRIANGLES, 12, GL_UNSIGNED_INT, (void*)(12 * sizeof(unsigned int)));
-
-		glUniform3f(colorLoc, 0.0f, 0.3f, 0.5f);
-		glUniform1f(alphaLoc, 0.3f);
-		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, (void*)(24 * sizeof(unsigned int)));
-
-		// Draw control panel with framebuffer texture
-		glUseProgram(textureShader);
-		glUniformMatrix4fv(glGetUniformLocation(textureShader, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-		glUniformMatrix4fv(glGetUniformLocation(textureShader, "view"), 1, GL_FALSE, glm::value_ptr(view));
-		glUniformMatrix4fv(glGetUniformLocation(textureShader, "model"), 1, GL_FALSE, glm::value_ptr(model));
-
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, textureColorbuffer);
-		glUniform1i(glGetUniformLocation(textureShader, "screenTexture"), 0);
-
-		glBindVertexArray(VAOcontrol);
-		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-		glBindVertexArray(0);
-
-		// Draw door with rotation animation
-		glUseProgram(shaderProgram);
+		// Sve povrsine kabine idu kroz red crtanja: neprovidne grupisane po programu,
+		// teksturi i VAO-u, providne (zidovi, šoferšajbna) od najdalje ka najblizoj
 		glm::mat4 doorModel = glm::mat4(1.0f);
 		doorModel = glm::translate(doorModel, glm::vec3(2.0f, 0.0f, -1.0f)); // Position door on right wall
-		doorModel = glm::rotate(doorModel, glm::radians(doorAngle), glm::vec3(0.0f, 1.0f, 0.0f)); // Rotate around hinge
-		glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "model"), 1, GL_FALSE, glm::value_ptr(doorModel));
-		glUniform3f(glGetUniformLocation(shaderProgram, "color"), 0.4f, 0.2f, 0.0f); // Brown color
-		glUniform1f(glGetUniformLocation(shaderProgram, "alpha"), 1.0f);
-		glBindVertexArray(VAOdoor);
-		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-		glBindVertexArray(0);
-
-		// Draw image in center of bus (opaque)
-		glUseProgram(textureShader);
-		glm::mat4 imageModel = glm::mat4(1.0f);
-		glUniformMatrix4fv(glGetUniformLocation(textureShader, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-		glUniformMatrix4fv(glGetUniformLocation(textureShader, "view"), 1, GL_FALSE, glm::value_ptr(view));
-		glUniformMatrix4fv(glGetUniformLocation(textureShader, "model"), 1, GL_FALSE, glm::value_ptr(imageModel));
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, imeTexture);
-		glUniform1i(glGetUniformLocation(textureShader, "screenTexture"), 0);
-		glBindVertexArray(VAOimage);
-		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-		glBindVertexArray(0);
+		doorModel = glm::rotate(doorModel, glm::radians(drawn.doorAngle), glm::vec3(0.0f, 1.0f, 0.0f)); // Rotate around hinge
+		const glm::mat4 cabinModels[CABIN_PART_COUNT] = { model, doorModel };
+		auto depthOf = [&](const glm::vec3& center) { return renderQueue.normalizedDepth(glm::length(center - cameraPos)); };
+
+		DrawItem cabin;
+		cabin.program = &shaderProgram;
+		cabin.vertexArray = cabinMesh.vertexArray();
+		cabin.indexCount = cabinMesh.opaqueIndexCount();
+		cabin.modelLocation = cabinModelLoc;
+		cabin.models = cabinModels;
+		cabin.modelCount = CABIN_PART_COUNT;
+		cabin.key = opaqueSortKey(RENDER_PASS_CABIN, shaderProgram.id(), 0, cabin.vertexArray, 0.0f);
+		renderQueue.push(cabin);
+
+		// Kontrolna tabla sa slikom mape i slika na sredini autobusa
+		DrawItem control;
+		control.program = &textureShader;
+		control.texture = minimap.colorTexture;
+		control.vertexArray = VAOcontrol;
+		control.indexCount = 6;
+		control.modelLocation = textureModelLoc;
+		control.models = &model;
+		control.key = opaqueSortKey(RENDER_PASS_CABIN, textureShader.id(), control.texture, VAOcontrol, depthOf(controlCenter));
+		renderQueue.push(control);
+
+		DrawItem image = control;
+		image.texture = atlasTexture;
+		image.vertexArray = VAOimage;
+		image.key = opaqueSortKey(RENDER_PASS_CABIN, textureShader.id(), atlasTexture, VAOimage, depthOf(imageCenter));
+		renderQueue.push(image);
+
+		for (const MeshSurface& surface : cabinMesh.translucent()) {
+			DrawItem item = cabin;
+			item.firstIndex = surface.firstIndex;
+			item.indexCount = surface.indexCount;
+			item.key = translucentSortKey(RENDER_PASS_CABIN, depthOf(surface.center), shaderProgram.id(), 0, item.vertexArray);
+			renderQueue.push(item);
+		}
+		RenderQueue::Stats queueStats = renderQueue.flush();
+		queueDraws += queueStats.draws;
+		queueProgramChanges += queueStats.programChanges;
 
 		glfwSwapBuffers(window);
+		frames++;
+		if (firstFrame) {
+			std::cout << "Prvi frejm: " << secondsSinceStart() * 1000.0 << " ms od pokretanja" << std::endl;
+			firstFrame = false;
+		}
 		glfwPollEvents();
 	}
 
-	glDeleteFramebuffers(1, &framebuffer);
-	glDeleteTextures(1, &textureColorbuffer);
-	glDeleteVertexArrays(1, &VAO);
+	if (frames > 0)
+		std::cout << "Kabina: " << (double)queueDraws / frames << " crtanja, " << (double)queueProgramChanges / frames
+			<< " promena programa po frejmu" << std::endl;
+	std::cout << "Mapa: " << minimapRedraws << " crtanja u " << frames << " frejmova, pozadina "
+		<< backgroundRedraws << " puta" << std::endl;
+	camera.destroy();
+	minimap.destroy();
+	minimapBackground.destroy();
+	textureStreamer.destroy();
+	cabinMesh.destroy();
 	glDeleteVertexArrays(1, &VAOcontrol);
-	glDeleteVertexArrays(1, &VAOdoor);
 	glDeleteVertexArrays(1, &VAOimage);
-	glDeleteVertexArrays(1, &VAObus2D);
-	glDeleteVertexArrays(1, &VAOstation2D);
+	sprites.destroy();
+	glDeleteTextures(1, &atlasTexture);
 	glDeleteVertexArrays(1, &VAOpath2D);
 	glfwTerminate();
 	return 0;
@@ -591,29 +803,21 @@ void processInput(GLFWwindow* window) {
 
 // Obrada tastature za kontrolu
 void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods) {
-	if (isWaiting) {
-		if (key == GLFW_KEY_K && action == GLFW_PRESS && !showControls) {
-			showControls = true;
-			if (passengersNumber != 0)
-				punishmentNumber = rand() % passengersNumber;
-			passengersNumber++;
-			std::cout << "Broj putnika: " << passengersNumber << std::endl;
-		}
+	if (key == GLFW_KEY_K && action == GLFW_PRESS && simulation.startControl()) {
+		std::cout << "Broj putnika: " << simulation.passengersNumber << std::endl;
 	}
+	if (key == GLFW_KEY_R && action == GLFW_PRESS)
+		spriteReloadRequested = true;
 }
 
 // Obrada miša za dodavanje/oduzimanje putnika
 void mouse_button_callback(GLFWwindow* window, int button, int action, int mods) {
-	if (isWaiting) {
-		if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS && passengersNumber < 50) {
-			passengersNumber++;
-			std::cout << "Broj putnika: " << passengersNumber << std::endl;
-		}
+	if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS && simulation.addPassenger()) {
+		std::cout << "Broj putnika: " << simulation.passengersNumber << std::endl;
+	}
 
-		if (button == GLFW_MOUSE_BUTTON_RIGHT && action == GLFW_PRESS && passengersNumber > 0) {
-			passengersNumber--;
-			std::cout << "Broj putnika: " << passengersNumber << std::endl;
-		}
+	if (button == GLFW_MOUSE_BUTTON_RIGHT && action == GLFW_PRESS && simulation.removePassenger()) {
+		std::cout << "Broj putnika: " << simulation.passengersNumber << std::endl;
 	}
 }
 
@@ -658,5 +862,6 @@ void mouse_callback(GLFWwindow* window, double xposIn, double yposIn) {
 
 // Promena veličine prozora
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
-	glViewport(0, 0, width, height);
+	// Viewport se postavlja pri crtanju (screenView.bind), jer ga mapa menja u svakom frejmu
+	screenView.resize(width, height);
 }
\ No newline at end of file
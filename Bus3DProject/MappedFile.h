@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+
+// Fajl mapiran u memoriju samo za citanje (mmap / MapViewOfFile).
+// Podaci se koriste direktno iz mapirane memorije, bez citanja i parsiranja.
+class MappedFile {
+public:
+	MappedFile() = default;
+	~MappedFile();
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool open(const char* filePath);
+	void close();
+
+	bool isOpen() const { return mapped != nullptr; }
+	const unsigned char* data() const { return mapped; }
+	size_t size() const { return length; }
+
+private:
+	const unsigned char* mapped = nullptr;
+	size_t length = 0;
+};
@@ -0,0 +1,124 @@
+#include "ProgramCache.h"
+#include "MappedFile.h"
+#include <GL/glew.h>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+// FNV-1a, 64 bita; nula izmedju delova da "ab" + "c" ne bude isto sto i "a" + "bc"
+static uint64_t hashText(uint64_t hash, const char* text) {
+	for (const unsigned char* c = (const unsigned char*)text; ; ++c) {
+		hash = (hash ^ *c) * 0x100000001B3ull;
+		if (*c == 0) return hash;
+	}
+}
+
+bool ProgramCache::open(const char* cacheDirectory) {
+	active = false;
+	int formats = 0;
+	if (GLEW_ARB_get_program_binary)
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+	if (formats == 0)
+		return false;
+
+	std::error_code error;
+	std::filesystem::create_directories(cacheDirectory, error);
+	if (error) {
+		std::cout << "Ne moze da se napravi direktorijum kesa sejdera: " << cacheDirectory << std::endl;
+		return false;
+	}
+	directory = cacheDirectory;
+	driver = std::string((const char*)glGetString(GL_VENDOR)) + "\n" +
+		(const char*)glGetString(GL_RENDERER) + "\n" + (const char*)glGetString(GL_VERSION);
+	active = true;
+	return true;
+}
+
+uint64_t ProgramCache::key(const char* vsSource, const char* fsSource) const {
+	return hashText(hashText(hashText(0xCBF29CE484222325ull, driver.c_str()), vsSource), fsSource);
+}
+
+std::string ProgramCache::filePath(uint64_t key) const {
+	char name[32];
+	snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+	return directory + "/" + name;
+}
+
+bool ProgramCache::load(const char* vsSource, const char* fsSource, unsigned int& program) const {
+	if (!active)
+		return false;
+	uint64_t key = this->key(vsSource, fsSource);
+	MappedFile file;
+	if (!file.open(filePath(key).c_str()))
+		return false;
+
+	ProgramCacheHeader header;
+	if (file.size() < sizeof(header))
+		return false;
+	memcpy(&header, file.data(), sizeof(header));
+	if (header.magic != PROGRAM_CACHE_MAGIC || header.version != PROGRAM_CACHE_VERSION || header.key != key ||
+		(uint64_t)sizeof(header) + header.driverLength + header.binaryLength != file.size())
+		return false;
+	// Hes moze da se poklopi i za drugi drajver; opis se poredi ceo
+	const char* storedDriver = (const char*)file.data() + sizeof(header);
+	if (header.driverLength != driver.size() || memcmp(storedDriver, driver.data(), driver.size()) != 0)
+		return false;
+
+	program = glCreateProgram();
+	glProgramBinary(program, header.binaryFormat, storedDriver + header.driverLength, (int)header.binaryLength);
+	int linked = 0;
+	glGetProgramiv(program, GL_LINK_STATUS, &linked);
+	if (!linked) {
+		// Drajver je odbio zapis (npr. posle azuriranja iste verzije); kompajlira se ponovo
+		glDeleteProgram(program);
+		program = 0;
+		return false;
+	}
+	return true;
+}
+
+void ProgramCache::store(const char* vsSource, const char* fsSource, unsigned int program) const {
+	if (!active)
+		return;
+	int linked = 0;
+	int length = 0;
+	glGetProgramiv(program, GL_LINK_STATUS, &linked);
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (!linked || length <= 0)
+		return;
+
+	std::vector<char> binary(length);
+	GLenum format = 0;
+	glGetProgramBinary(program, length, &length, &format, binary.data());
+
+	uint64_t key = this->key(vsSource, fsSource);
+	std::string path = filePath(key);
+	ProgramCacheHeader header = {};
+	header.magic = PROGRAM_CACHE_MAGIC;
+	header.version = PROGRAM_CACHE_VERSION;
+	header.key = key;
+	header.binaryFormat = format;
+	header.driverLength = (uint32_t)driver.size();
+	header.binaryLength = (uint32_t)length;
+
+	// Upis u privremeni fajl pa preimenovanje, da prekinut upis ne ostavi pola zapisa
+	std::string tempPath = path + ".tmp";
+	FILE* file = fopen(tempPath.c_str(), "wb");
+	if (!file) {
+		std::cout << "Ne moze da se otvori fajl za upis: " << tempPath << std::endl;
+		return;
+	}
+	bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+		fwrite(driver.data(), 1, driver.size(), file) == driver.size() &&
+		fwrite(binary.data(), 1, length, file) == (size_t)length;
+	written = (fclose(file) == 0) && written;
+	std::error_code error;
+	if (written)
+		std::filesystem::rename(tempPath, path, error);
+	if (!written || error) {
+		std::cout << "Greska pri upisu fajla: " << path << std::endl;
+		std::filesystem::remove(tempPath, error);
+	}
+}
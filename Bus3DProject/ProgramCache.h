@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Kes linkovanih programa na disku: posle prvog pokretanja program se ucitava
+// sa glProgramBinary umesto kompajliranja i linkovanja iz izvornog koda
+// (ShaderCompiler prvo pita kes, pa tek onda kompajlira).
+// Kljuc je hes izvornog koda oba sejdera i drajvera (GL_VENDOR, GL_RENDERER,
+// GL_VERSION); kada se nesto od toga promeni, ili drajver odbije binarni
+// zapis, program se kompajlira iz izvornog koda i zapis se prepisuje.
+
+const uint32_t PROGRAM_CACHE_MAGIC = 0x47525042; // "BPRG"
+const uint32_t PROGRAM_CACHE_VERSION = 1;
+const char* const PROGRAM_CACHE_DEFAULT_DIR = "shader_cache";
+
+struct ProgramCacheHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t key;
+	uint32_t binaryFormat;
+	uint32_t driverLength; // posle zaglavlja: opis drajvera, pa binarni program
+	uint32_t binaryLength;
+	uint32_t reserved;
+};
+
+class ProgramCache {
+public:
+	// Posle pravljenja GL konteksta; false ako drajver ne podrzava binarne programe
+	bool open(const char* directory);
+	bool enabled() const { return active; }
+
+	// Linkovan program iz vazeceg zapisa za ove izvore; false ako ga nema
+	bool load(const char* vsSource, const char* fsSource, unsigned int& program) const;
+	// Upisuje program linkovan sa GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+	void store(const char* vsSource, const char* fsSource, unsigned int program) const;
+
+private:
+	uint64_t key(const char* vsSource, const char* fsSource) const;
+	std::string filePath(uint64_t key) const;
+
+	std::string directory;
+	std::string driver;
+	bool active = false;
+};
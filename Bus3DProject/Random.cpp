@@ -0,0 +1,30 @@
+#include "Random.h"
+#include <iostream>
+
+static uint64_t globalSeed = 0;
+
+uint64_t pcg32InitialState(uint64_t seed, uint64_t stream) {
+	uint64_t increment = pcg32Increment(stream);
+	uint64_t state = 0;
+	pcg32Next(state, increment);
+	state += seed;
+	pcg32Next(state, increment);
+	return state;
+}
+
+Pcg32::Pcg32(uint64_t seed, uint64_t stream)
+	: state(pcg32InitialState(seed, stream)), increment(pcg32Increment(stream)) {
+}
+
+void initRandomSeed(uint64_t seed) {
+	globalSeed = seed;
+	std::cout << "Seme: " << seed << " (ponavljanje sa --seed " << seed << ")" << std::endl;
+}
+
+uint64_t randomSeed() {
+	return globalSeed;
+}
+
+Pcg32 randomStream(uint64_t stream) {
+	return Pcg32(globalSeed, stream);
+}
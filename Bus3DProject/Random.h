@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+
+// PCG32 generator (O'Neill, pcg-random.org): 64 bita stanja, 32 bita izlaza.
+// Svaki tok (stream) je nezavisna sekvenca za isto seme, pa svaki autobus moze
+// imati svoj generator bez deljenja stanja izmedju niti, a paralelne voznje
+// ostaju ponovljive.
+
+// Identifikatori tokova; vozac autobusa i koristi RANDOM_STREAM_DRIVER + i
+const uint64_t RANDOM_STREAM_ROUTE = 1;
+const uint64_t RANDOM_STREAM_DRIVER = 1ull << 32;
+
+inline uint64_t pcg32Increment(uint64_t stream) {
+	return (stream << 1u) | 1u;
+}
+
+inline uint32_t pcg32Next(uint64_t& state, uint64_t increment) {
+	uint64_t old = state;
+	state = old * 6364136223846793005ull + increment;
+	uint32_t xorshifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+	uint32_t rot = (uint32_t)(old >> 59u);
+	return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+}
+
+// Broj u [0, bound) bez pristrasnosti (bound == 0 vraca 0)
+inline uint32_t pcg32Below(uint64_t& state, uint64_t increment, uint32_t bound) {
+	if (bound == 0) return 0;
+	uint32_t threshold = (0u - bound) % bound;
+	for (;;) {
+		uint32_t r = pcg32Next(state, increment);
+		if (r >= threshold) return r % bound;
+	}
+}
+
+// Pocetno stanje toka za dato seme
+uint64_t pcg32InitialState(uint64_t seed, uint64_t stream);
+
+struct Pcg32 {
+	uint64_t state = 0;
+	uint64_t increment = 1;
+
+	Pcg32() = default;
+	Pcg32(uint64_t seed, uint64_t stream);
+
+	uint32_t next() { return pcg32Next(state, increment); }
+	uint32_t nextBelow(uint32_t bound) { return pcg32Below(state, increment, bound); }
+	// Broj u [0, 1)
+	float nextFloat() { return (next() >> 8) * (1.0f / 16777216.0f); }
+};
+
+// Globalno seme; svi tokovi se izvode iz njega. Postavlja se jednom i ispisuje,
+// da bi voznja mogla da se ponovi sa --seed.
+void initRandomSeed(uint64_t seed);
+uint64_t randomSeed();
+Pcg32 randomStream(uint64_t stream);
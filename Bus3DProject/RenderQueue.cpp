@@ -0,0 +1,68 @@
+#include "RenderQueue.h"
+#include <algorithm>
+#include <utility>
+
+static uint64_t quantizeDepth(float depth) {
+	const uint64_t maxDepth = (1u << 24) - 1;
+	float clamped = std::min(std::max(depth, 0.0f), 1.0f);
+	return (uint64_t)(clamped * maxDepth);
+}
+
+static uint64_t stateBits(unsigned int program, unsigned int texture, unsigned int vertexArray) {
+	return ((uint64_t)(program & 0xFFF) << 24) | ((uint64_t)(texture & 0xFFF) << 12) | (uint64_t)(vertexArray & 0xFFF);
+}
+
+uint64_t opaqueSortKey(int pass, unsigned int program, unsigned int texture, unsigned int vertexArray, float depth) {
+	return ((uint64_t)(pass & 3) << 62) | (stateBits(program, texture, vertexArray) << 24) | quantizeDepth(depth);
+}
+
+uint64_t translucentSortKey(int pass, float depth, unsigned int program, unsigned int texture, unsigned int vertexArray) {
+	const uint64_t maxDepth = (1u << 24) - 1;
+	return ((uint64_t)(pass & 3) << 62) | (1ull << 61) | ((maxDepth - quantizeDepth(depth)) << 36) |
+		stateBits(program, texture, vertexArray);
+}
+
+RenderQueue::Stats RenderQueue::flush() {
+	std::stable_sort(items.begin(), items.end(), [](const DrawItem& a, const DrawItem& b) { return a.key < b.key; });
+
+	Stats stats;
+	const ShaderProgram* program = nullptr;
+	unsigned int texture = 0;
+	unsigned int vertexArray = 0;
+	// Poslednja poslata matrica modela za svaki program
+	std::vector<std::pair<const ShaderProgram*, const glm::mat4*>> sentModels;
+
+	glActiveTexture(GL_TEXTURE0);
+	for (const DrawItem& item : items) {
+		if (item.program != program) {
+			program = item.program;
+			program->use();
+			stats.programChanges++;
+		}
+		if (item.texture != 0 && item.texture != texture) {
+			texture = item.texture;
+			glBindTexture(GL_TEXTURE_2D, texture);
+			stats.textureChanges++;
+		}
+		if (item.vertexArray != vertexArray) {
+			vertexArray = item.vertexArray;
+			glBindVertexArray(vertexArray);
+			stats.vertexArrayChanges++;
+		}
+		if (item.models && item.modelLocation >= 0) {
+			auto sent = std::find_if(sentModels.begin(), sentModels.end(), [&](const auto& entry) { return entry.first == program; });
+			if (sent == sentModels.end() || sent->second != item.models) {
+				program->setMat4Array(item.modelLocation, item.models, item.modelCount);
+				if (sent == sentModels.end())
+					sentModels.push_back({ program, item.models });
+				else
+					sent->second = item.models;
+			}
+		}
+		glDrawElements(GL_TRIANGLES, item.indexCount, GL_UNSIGNED_INT, (void*)(item.firstIndex * sizeof(unsigned int)));
+		stats.draws++;
+	}
+	glBindVertexArray(0);
+	items.clear();
+	return stats;
+}
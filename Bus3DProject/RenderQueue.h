@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "ShaderProgram.h"
+
+// Jedno crtanje indeksiranih trouglova (GL_UNSIGNED_INT) sa svim stanjem koje mu treba
+struct DrawItem {
+	uint64_t key = 0;
+	const ShaderProgram* program = nullptr;
+	unsigned int texture = 0; // na jedinici 0; 0 = bez teksture
+	unsigned int vertexArray = 0;
+	int firstIndex = 0;
+	int indexCount = 0;
+	// Matrica modela (ili niz, npr. model[2] u basic.vert); salje se samo
+	// kada se razlikuje od poslednje poslate za isti program u ovom frejmu
+	int modelLocation = -1;
+	const glm::mat4* models = nullptr;
+	int modelCount = 1;
+};
+
+// Kljuc sortiranja, 64 bita, od najvisih bitova:
+//   neprovidno: prolaz (2) | 0 | program (12) | tekstura (12) | VAO (12) | dubina (24, napred ka nazad)
+//   providno:   prolaz (2) | 1 | dubina (24, nazad ka napred) | program (12) | tekstura (12) | VAO (12)
+// Neprovidna crtanja se grupisu po stanju (dubina samo unutar grupe, zbog
+// ranog odbacivanja fragmenata), a providna moraju od najdaljeg ka najblizem,
+// pa tu dubina ide ispred stanja. OpenGL imena se uzimaju po modulu 4096;
+// poklapanje samo razdvaja grupu, redosled ostaje ispravan.
+uint64_t opaqueSortKey(int pass, unsigned int program, unsigned int texture, unsigned int vertexArray, float depth);
+uint64_t translucentSortKey(int pass, float depth, unsigned int program, unsigned int texture, unsigned int vertexArray);
+
+// Dubina se zadaje kao udaljenost od kamere u [0, farPlane]
+class RenderQueue {
+public:
+	struct Stats {
+		int draws = 0;
+		int programChanges = 0;
+		int textureChanges = 0;
+		int vertexArrayChanges = 0;
+	};
+
+	void setFarPlane(float farPlane) { depthScale = farPlane > 0.0f ? 1.0f / farPlane : 1.0f; }
+	float normalizedDepth(float distance) const { return distance * depthScale; }
+
+	void push(const DrawItem& item) { items.push_back(item); }
+	// Sortira po kljucu, crta i prazni red; program, tekstura i VAO se menjaju
+	// samo kada se razlikuju od prethodnog crtanja
+	Stats flush();
+
+private:
+	std::vector<DrawItem> items;
+	float depthScale = 1.0f;
+};
@@ -0,0 +1,68 @@
+#include "RenderView.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <iostream>
+
+bool RenderView::resize(int newWidth, int newHeight) {
+	if (newWidth <= 0 || newHeight <= 0) return false;
+	if (newWidth == width && newHeight == height) return false;
+	width = newWidth;
+	height = newHeight;
+	projection = glm::perspective(glm::radians(fovDegrees), (float)width / (float)height, nearPlane, farPlane);
+	generation++;
+	return true;
+}
+
+void RenderView::bind() const {
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glViewport(0, 0, width, height);
+}
+
+void RenderTarget::create(int newWidth, int newHeight) {
+	glGenFramebuffers(1, &framebuffer);
+	glGenTextures(1, &colorTexture);
+	glBindTexture(GL_TEXTURE_2D, colorTexture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	resize(newWidth, newHeight);
+}
+
+bool RenderTarget::resize(int newWidth, int newHeight) {
+	if (newWidth <= 0 || newHeight <= 0) return false;
+	if (newWidth == width && newHeight == height) return false;
+	width = newWidth;
+	height = newHeight;
+
+	glBindTexture(GL_TEXTURE_2D, colorTexture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0);
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		std::cout << "ERROR::FRAMEBUFFER:: Framebuffer is not complete!" << std::endl;
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	return true;
+}
+
+void RenderTarget::bind() const {
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glViewport(0, 0, width, height);
+}
+
+void RenderTarget::copyTo(const RenderTarget& target) const {
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, target.framebuffer);
+	GLenum filter = (width == target.width && height == target.height) ? GL_NEAREST : GL_LINEAR;
+	glBlitFramebuffer(0, 0, width, height, 0, 0, target.width, target.height, GL_COLOR_BUFFER_BIT, filter);
+	target.bind();
+}
+
+void RenderTarget::destroy() {
+	glDeleteFramebuffers(1, &framebuffer);
+	glDeleteTextures(1, &colorTexture);
+	framebuffer = 0;
+	colorTexture = 0;
+	width = 0;
+	height = 0;
+}
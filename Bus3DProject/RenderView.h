@@ -0,0 +1,58 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+// Podrazumevani framebuffer prozora u stvarnoj velicini u pikselima (HiDPI
+// ekrani imaju vise piksela od velicine prozora). Projekcija se racuna samo
+// kada se velicina zaista promeni; generation raste pri svakoj promeni, pa
+// zavisni ciljevi (RenderTarget) znaju kada treba da se realociraju.
+struct RenderView {
+	int width = 0;
+	int height = 0;
+	float fovDegrees = 45.0f;
+	float nearPlane = 0.1f;
+	float farPlane = 100.0f;
+	glm::mat4 projection = glm::mat4(1.0f);
+	unsigned int generation = 0;
+
+	// Vraca true ako se velicina promenila; 0 x 0 (minimizovan prozor) se ignorise
+	bool resize(int newWidth, int newHeight);
+	void bind() const;
+};
+
+// FBO sa teksturom boje, velicina se menja samo na zahtev
+struct RenderTarget {
+	unsigned int framebuffer = 0;
+	unsigned int colorTexture = 0;
+	int width = 0;
+	int height = 0;
+
+	void create(int newWidth, int newHeight);
+	// Realocira teksturu samo ako je velicina drugacija
+	bool resize(int newWidth, int newHeight);
+	void bind() const;
+	// Kopira sliku u target (glBlitFramebuffer) i ostavlja target vezan za crtanje
+	void copyTo(const RenderTarget& target) const;
+	void destroy();
+};
+
+// Ponovno crtanje cilja samo kada se sadrzaj promeni (invalidate), i najvise
+// jednom na svakih minInterval sekundi, nezavisno od broja frejmova ekrana.
+// Izmedju dva crtanja ekran koristi poslednju nacrtanu teksturu.
+struct RefreshLimiter {
+	double minInterval = 0.0; // 0 = bez ogranicenja
+	double lastRefresh = 0.0;
+	bool dirty = true;
+	bool forced = true;
+
+	void invalidate() { dirty = true; }
+	// Sadrzaj teksture nije vise vazeci (npr. posle realokacije); crta se odmah
+	void force() { dirty = forced = true; }
+	bool shouldRefresh(double now) {
+		if (!dirty || (!forced && now - lastRefresh < minInterval))
+			return false;
+		dirty = forced = false;
+		lastRefresh = now;
+		return true;
+	}
+};
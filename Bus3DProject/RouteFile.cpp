@@ -0,0 +1,152 @@
+#include "RouteFile.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+// Dodaje niz na kraj bafera i vraca njegov pomeraj
+template <typename T>
+uint32_t appendArray(std::vector<unsigned char>& buffer, const T* items, size_t count) {
+	uint32_t offset = (uint32_t)buffer.size();
+	buffer.resize(buffer.size() + count * sizeof(T));
+	if (count > 0) memcpy(buffer.data() + offset, items, count * sizeof(T));
+	return offset;
+}
+
+// Niz od count elemenata velicine itemSize na pomeraju offset staje u fajl
+bool arrayFits(size_t fileSize, uint32_t offset, uint64_t count, size_t itemSize) {
+	if (offset % 4 != 0 || offset > fileSize) return false;
+	return count * itemSize <= fileSize - offset;
+}
+
+}
+
+bool writeRouteFile(const char* filePath, const BusRoute& route) {
+	const RoutePath& path = route.path;
+	uint32_t numStops = (uint32_t)route.numStations;
+	uint32_t numPoints = (uint32_t)path.numSegments() + 1;
+
+	std::vector<uint32_t> stopStations(numStops);
+	std::vector<RouteFileSegment> segments(numStops);
+	std::vector<uint32_t> stopVertex(numStops);
+	for (uint32_t i = 0; i < numStops; ++i) {
+		stopStations[i] = i;
+		stopVertex[i] = (uint32_t)path.findSegment(route.stationDistance[i]);
+	}
+	for (uint32_t i = 0; i < numStops; ++i) {
+		uint32_t next = (i + 1) % numStops;
+		uint32_t lastPoint = (next == 0) ? numPoints - 1 : stopVertex[next];
+		segments[i].fromStop = i;
+		segments[i].toStop = next;
+		segments[i].firstPoint = stopVertex[i];
+		segments[i].pointCount = lastPoint - stopVertex[i] + 1;
+	}
+
+	// Poslednje teme nema svoju deonicu
+	std::vector<float> inverse(path.inverseLength, path.inverseLength + path.numSegments());
+	inverse.push_back(0.0f);
+
+	RouteFileLine line = { 0, numStops, 0, 0, numPoints };
+
+	RouteFileHeader header = {};
+	header.magic = ROUTE_FILE_MAGIC;
+	header.version = ROUTE_FILE_VERSION;
+	header.numStations = numStops;
+	header.numLines = 1;
+	header.numStops = numStops;
+	header.numSegments = numStops;
+	header.numPoints = numPoints;
+
+	std::vector<unsigned char> buffer(sizeof(header));
+	header.stationsOffset = appendArray(buffer, route.stationPositions, 2 * (size_t)numStops);
+	header.linesOffset = appendArray(buffer, &line, 1);
+	header.stopStationsOffset = appendArray(buffer, stopStations.data(), numStops);
+	header.stopPositionsOffset = appendArray(buffer, route.stationPositions, 2 * (size_t)numStops);
+	header.stopDistancesOffset = appendArray(buffer, route.stationDistance, numStops);
+	header.segmentsOffset = appendArray(buffer, segments.data(), numStops);
+	header.pointsOffset = appendArray(buffer, path.points, 2 * (size_t)numPoints);
+	header.cumulativeOffset = appendArray(buffer, path.cumulativeLength, numPoints);
+	header.inverseOffset = appendArray(buffer, inverse.data(), numPoints);
+	memcpy(buffer.data(), &header, sizeof(header));
+
+	FILE* file = fopen(filePath, "wb");
+	if (!file) {
+		std::cout << "Ne moze da se otvori fajl za upis: " << filePath << std::endl;
+		return false;
+	}
+	bool written = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+	written = (fclose(file) == 0) && written;
+	if (!written)
+		std::cout << "Greska pri upisu fajla: " << filePath << std::endl;
+	return written;
+}
+
+bool loadRouteFile(const char* filePath, BusRoute& route, int line) {
+	MappedFile file;
+	if (!file.open(filePath)) {
+		std::cout << "Ne moze da se otvori fajl linije: " << filePath << std::endl;
+		return false;
+	}
+
+	// Provera je O(1): samo zaglavlje i granice nizova, bez prolaska kroz podatke
+	size_t size = file.size();
+	const unsigned char* data = file.data();
+	RouteFileHeader header;
+	if (size < sizeof(header)) {
+		std::cout << "Fajl linije je prekratak: " << filePath << std::endl;
+		return false;
+	}
+	memcpy(&header, data, sizeof(header));
+	if (header.magic != ROUTE_FILE_MAGIC || header.version != ROUTE_FILE_VERSION) {
+		std::cout << "Nepoznat format fajla linije: " << filePath << std::endl;
+		return false;
+	}
+	bool valid = arrayFits(size, header.stationsOffset, 2ull * header.numStations, sizeof(float))
+		&& arrayFits(size, header.linesOffset, header.numLines, sizeof(RouteFileLine))
+		&& arrayFits(size, header.stopStationsOffset, header.numStops, sizeof(uint32_t))
+		&& arrayFits(size, header.stopPositionsOffset, 2ull * header.numStops, sizeof(float))
+		&& arrayFits(size, header.stopDistancesOffset, header.numStops, sizeof(float))
+		&& arrayFits(size, header.segmentsOffset, header.numSegments, sizeof(RouteFileSegment))
+		&& arrayFits(size, header.pointsOffset, 2ull * header.numPoints, sizeof(float))
+		&& arrayFits(size, header.cumulativeOffset, header.numPoints, sizeof(float))
+		&& arrayFits(size, header.inverseOffset, header.numPoints, sizeof(float));
+	if (!valid) {
+		std::cout << "Ostecen fajl linije: " << filePath << std::endl;
+		return false;
+	}
+	if (line < 0 || (uint32_t)line >= header.numLines) {
+		std::cout << "Linija " << line << " ne postoji (ukupno " << header.numLines << ")" << std::endl;
+		return false;
+	}
+
+	RouteFileLine lineInfo;
+	memcpy(&lineInfo, data + header.linesOffset + line * sizeof(RouteFileLine), sizeof(lineInfo));
+	if (lineInfo.stopCount < 2 || lineInfo.pointCount < 2
+		|| (uint64_t)lineInfo.firstStop + lineInfo.stopCount > header.numStops
+		|| (uint64_t)lineInfo.firstPoint + lineInfo.pointCount > header.numPoints) {
+		std::cout << "Ostecen opis linije " << line << ": " << filePath << std::endl;
+		return false;
+	}
+
+	const float* stopPositions = (const float*)(data + header.stopPositionsOffset);
+	const float* stopDistances = (const float*)(data + header.stopDistancesOffset);
+	const float* points = (const float*)(data + header.pointsOffset);
+	const float* cumulative = (const float*)(data + header.cumulativeOffset);
+	const float* inverse = (const float*)(data + header.inverseOffset);
+	if (cumulative[lineInfo.firstPoint] != 0.0f) {
+		std::cout << "Duzina luka linije " << line << " ne pocinje od 0: " << filePath << std::endl;
+		return false;
+	}
+
+	route = BusRoute();
+	route.numStations = (int)lineInfo.stopCount;
+	route.stationPositions = stopPositions + 2 * (size_t)lineInfo.firstStop;
+	route.stationDistance = stopDistances + lineInfo.firstStop;
+	route.path.attach(points + 2 * (size_t)lineInfo.firstPoint, cumulative + lineInfo.firstPoint,
+		inverse + lineInfo.firstPoint, (int)lineInfo.pointCount - 1);
+	// Premestanje mapiranja ne menja adrese, pokazivaci ostaju ispravni
+	route.file = std::move(file);
+	return true;
+}
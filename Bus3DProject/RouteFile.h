@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include "BusSimulation.h"
+
+// Binarni format mreze linija koji se koristi direktno iz mapirane memorije,
+// bez parsiranja: zaglavlje sa pomerajima, a zatim nizovi fiksne velicine
+// (little-endian, poravnati na 4 bajta). Ucitavanje linije je O(1) bez obzira
+// na velicinu mreze, jer se samo proveri zaglavlje i postave pokazivaci.
+//
+// Linija je zatvoren krug stajalista. Za svako stajaliste cuva se stanica,
+// pozicija i udaljenost na putanji, a za svaku deonicu (stajaliste -> sledece)
+// opseg temena putanje. Putanja linije je neprekidan niz temena (prvo ponovljeno
+// na kraju) sa unapred izracunatom tabelom duzine luka, pa je RoutePath samo pogled na fajl.
+// Tabela duzine luka i udaljenosti stajalista su lokalne za liniju: kumulativna
+// duzina prvog temena svake linije je 0, inace se fajl odbija pri ucitavanju.
+
+const uint32_t ROUTE_FILE_MAGIC = 0x46545242; // "BRTF"
+const uint32_t ROUTE_FILE_VERSION = 1;
+
+struct RouteFileHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t numStations;
+	uint32_t numLines;
+	uint32_t numStops;
+	uint32_t numSegments;
+	uint32_t numPoints;
+	// Pomeraji od pocetka fajla
+	uint32_t stationsOffset;      // float x, y [numStations]
+	uint32_t linesOffset;         // RouteFileLine [numLines]
+	uint32_t stopStationsOffset;  // uint32_t [numStops]
+	uint32_t stopPositionsOffset; // float x, y [numStops]
+	uint32_t stopDistancesOffset; // float [numStops]
+	uint32_t segmentsOffset;      // RouteFileSegment [numSegments]
+	uint32_t pointsOffset;        // float x, y [numPoints]
+	uint32_t cumulativeOffset;    // float [numPoints]
+	uint32_t inverseOffset;       // float [numPoints]
+};
+
+struct RouteFileLine {
+	uint32_t firstStop;
+	uint32_t stopCount;
+	uint32_t firstSegment;
+	uint32_t firstPoint;
+	uint32_t pointCount; // ukljucujuci ponovljeno prvo teme
+};
+
+struct RouteFileSegment {
+	uint32_t fromStop;
+	uint32_t toStop;
+	uint32_t firstPoint;
+	uint32_t pointCount; // ukljucujuci oba kraja
+};
+
+// Upisuje mrezu sa jednom linijom
+bool writeRouteFile(const char* filePath, const BusRoute& route);
+// Mapira fajl i postavlja route na zadatu liniju; route drzi mapiranje zivim
+bool loadRouteFile(const char* filePath, BusRoute& route, int line = 0);
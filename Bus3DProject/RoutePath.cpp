@@ -0,0 +1,71 @@
+#include "RoutePath.h"
+#include <algorithm>
+#include <cmath>
+
+void RoutePath::build(const float* vertices, int count) {
+	ownedPoints.assign(vertices, vertices + 2 * count);
+	ownedPoints.push_back(vertices[0]);
+	ownedPoints.push_back(vertices[1]);
+	ownedCumulative.resize(count + 1);
+	ownedInverse.resize(count);
+	ownedCumulative[0] = 0.0f;
+	for (int k = 0; k < count; ++k) {
+		float dx = ownedPoints[2 * k + 2] - ownedPoints[2 * k];
+		float dy = ownedPoints[2 * k + 3] - ownedPoints[2 * k + 1];
+		float length = sqrt(dx * dx + dy * dy);
+		ownedCumulative[k + 1] = ownedCumulative[k] + length;
+		ownedInverse[k] = length > 0.0f ? 1.0f / length : 0.0f;
+	}
+	attach(ownedPoints.data(), ownedCumulative.data(), ownedInverse.data(), count);
+}
+
+void RoutePath::attach(const float* pointData, const float* cumulativeData, const float* inverseData, int count) {
+	points = pointData;
+	cumulativeLength = cumulativeData;
+	inverseLength = inverseData;
+	segmentCount = count;
+}
+
+float RoutePath::wrapSlow(float distance) const {
+	float total = totalLength();
+	if (total <= 0.0f) return 0.0f;
+	// Najcesci slucaj: autobus je tacno na kraju kruga
+	if (distance >= total && distance < 2.0f * total) return distance - total;
+	distance = fmod(distance, total);
+	return distance < 0.0f ? distance + total : distance;
+}
+
+int RoutePath::findSegment(float distance) const {
+	// Prvi element veci od distance, pa deonica pre njega
+	const float* it = std::upper_bound(cumulativeLength, cumulativeLength + segmentCount, distance);
+	int segment = (int)(it - cumulativeLength) - 1;
+	return std::clamp(segment, 0, numSegments() - 1);
+}
+
+int RoutePath::findSegment(float distance, int& cursor) const {
+	int last = numSegments() - 1;
+	if (cursor < 0 || cursor > last || distance < cumulativeLength[cursor]) {
+		// Kursor je ispred (npr. posle kruga), trazi se iz pocetka
+		cursor = findSegment(distance);
+		return cursor;
+	}
+	while (cursor < last && distance >= cumulativeLength[cursor + 1])
+		cursor++;
+	return cursor;
+}
+
+void RoutePath::pointOnSegment(int segment, float distance, float& x, float& y) const {
+	float u = std::min((distance - cumulativeLength[segment]) * inverseLength[segment], 1.0f);
+	x = points[2 * segment] * (1.0f - u) + points[2 * segment + 2] * u;
+	y = points[2 * segment + 1] * (1.0f - u) + points[2 * segment + 3] * u;
+}
+
+void RoutePath::tangentOfSegment(int segment, float& tx, float& ty) const {
+	if (inverseLength[segment] == 0.0f) {
+		tx = 1.0f;
+		ty = 0.0f;
+		return;
+	}
+	tx = (points[2 * segment + 2] - points[2 * segment]) * inverseLength[segment];
+	ty = (points[2 * segment + 3] - points[2 * segment + 1]) * inverseLength[segment];
+}
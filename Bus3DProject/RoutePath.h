@@ -0,0 +1,50 @@
+#pragma once
+#include <vector>
+
+// Zatvorena izlomljena linija sa tabelom kumulativne duzine luka, tako da se
+// pozicija na putanji trazi po predjenom putu (konstantna brzina), nezavisno
+// od toga koliko su temena gusto rasporedjena. Tabele mogu biti u sopstvenoj
+// memoriji (build) ili tudje, npr. iz mapiranog fajla linije (attach).
+struct RoutePath {
+	const float* points = nullptr;           // x, y parovi; prvo teme je ponovljeno na kraju
+	const float* cumulativeLength = nullptr; // cumulativeLength[k] = duzina do temena k, numSegments() + 1 elemenata
+	const float* inverseLength = nullptr;    // 1 / duzina deonice (0 za deonice nulte duzine)
+	int segmentCount = 0;
+
+	RoutePath() = default;
+	RoutePath(RoutePath&&) = default;
+	RoutePath& operator=(RoutePath&&) = default;
+	// Pokazivaci bi posle kopiranja pokazivali na tudju memoriju
+	RoutePath(const RoutePath&) = delete;
+	RoutePath& operator=(const RoutePath&) = delete;
+
+	// Broj deonica (= broj razlicitih temena zatvorene linije)
+	int numSegments() const { return segmentCount; }
+	float totalLength() const { return segmentCount > 0 ? cumulativeLength[segmentCount] : 0.0f; }
+
+	void build(const float* vertices, int count);
+	void attach(const float* pointData, const float* cumulativeData, const float* inverseData, int count);
+
+	// Deonica k ide od temena k do temena k + 1; O(log n) binarnom pretragom
+	int findSegment(float distance) const;
+	// O(1) za monotono rastuce udaljenosti: kursor se pomera samo unapred
+	int findSegment(float distance, int& cursor) const;
+
+	void pointOnSegment(int segment, float distance, float& x, float& y) const;
+	// Jedinicni vektor pravca deonice
+	void tangentOfSegment(int segment, float& tx, float& ty) const;
+
+	// Udaljenost se svodi na [0, ukupna duzina)
+	float wrap(float distance) const {
+		float total = totalLength();
+		if (distance >= 0.0f && distance < total) return distance;
+		return wrapSlow(distance);
+	}
+
+private:
+	float wrapSlow(float distance) const;
+
+	std::vector<float> ownedPoints;
+	std::vector<float> ownedCumulative;
+	std::vector<float> ownedInverse;
+};
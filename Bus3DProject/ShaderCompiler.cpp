@@ -0,0 +1,113 @@
+#include "ShaderCompiler.h"
+#include <iostream>
+
+static std::string shaderLog(unsigned int shader) {
+	int length = 0;
+	glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+	std::string log(length > 0 ? length : 0, '\0');
+	if (length > 0)
+		glGetShaderInfoLog(shader, length, nullptr, &log[0]);
+	return log.c_str();
+}
+
+static std::string programLog(unsigned int program) {
+	int length = 0;
+	glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+	std::string log(length > 0 ? length : 0, '\0');
+	if (length > 0)
+		glGetProgramInfoLog(program, length, nullptr, &log[0]);
+	return log.c_str();
+}
+
+static unsigned int submitShader(GLenum type, const std::string& source) {
+	unsigned int shader = glCreateShader(type);
+	const char* text = source.c_str();
+	glShaderSource(shader, 1, &text, NULL);
+	glCompileShader(shader);
+	return shader;
+}
+
+void ShaderCompiler::begin(ProgramCache* programCache) {
+	cache = programCache;
+	parallelCompile = GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+	// 0xFFFFFFFF: drajver bira broj niti
+	if (GLEW_KHR_parallel_shader_compile)
+		glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+	else if (GLEW_ARB_parallel_shader_compile)
+		glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+}
+
+void ShaderCompiler::submit(const char* name, const std::string& vsSource, const std::string& fsSource, ShaderProgram* target) {
+	Pending entry = { name, vsSource, fsSource, target, 0, 0, 0, false };
+	if (cache && cache->load(vsSource.c_str(), fsSource.c_str(), entry.program)) {
+		entry.fromCache = true;
+		hits++;
+	}
+	else {
+		misses++;
+		entry.vs = submitShader(GL_VERTEX_SHADER, vsSource);
+		entry.fs = submitShader(GL_FRAGMENT_SHADER, fsSource);
+		entry.program = glCreateProgram();
+		glAttachShader(entry.program, entry.vs);
+		glAttachShader(entry.program, entry.fs);
+		if (cache && cache->enabled())
+			glProgramParameteri(entry.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		glLinkProgram(entry.program);
+	}
+	pending.push_back(std::move(entry));
+}
+
+bool ShaderCompiler::ready() const {
+	if (!parallelCompile)
+		return true;
+	for (const Pending& entry : pending) {
+		int done = GL_TRUE;
+		if (!entry.fromCache)
+			glGetProgramiv(entry.program, GL_COMPLETION_STATUS_KHR, &done);
+		if (!done)
+			return false;
+	}
+	return true;
+}
+
+bool ShaderCompiler::finish() {
+	bool succeeded = true;
+	for (Pending& entry : pending) {
+		if (entry.fromCache) {
+			*entry.target = ShaderProgram(entry.program);
+			continue;
+		}
+
+		int vsCompiled = 0, fsCompiled = 0, linked = 0;
+		glGetShaderiv(entry.vs, GL_COMPILE_STATUS, &vsCompiled);
+		glGetShaderiv(entry.fs, GL_COMPILE_STATUS, &fsCompiled);
+		glGetProgramiv(entry.program, GL_LINK_STATUS, &linked);
+		std::string vsLog = shaderLog(entry.vs);
+		std::string fsLog = shaderLog(entry.fs);
+		std::string linkLog = programLog(entry.program);
+
+		if (!vsCompiled)
+			std::cerr << "GREŠKA: Vertex sejder programa " << entry.name << " se ne kompajlira:\n" << vsLog << std::endl;
+		if (!fsCompiled)
+			std::cerr << "GREŠKA: Fragment sejder programa " << entry.name << " se ne kompajlira:\n" << fsLog << std::endl;
+		if (vsCompiled && fsCompiled && !linked)
+			std::cerr << "GREŠKA: Program " << entry.name << " se ne linkuje:\n" << linkLog << std::endl;
+		if (vsCompiled && fsCompiled && linked && !(vsLog + fsLog + linkLog).empty())
+			std::cout << "Upozorenja za program " << entry.name << ":\n" << vsLog << fsLog << linkLog << std::endl;
+
+		glDetachShader(entry.program, entry.vs);
+		glDetachShader(entry.program, entry.fs);
+		glDeleteShader(entry.vs);
+		glDeleteShader(entry.fs);
+		if (!linked) {
+			glDeleteProgram(entry.program);
+			succeeded = false;
+			continue;
+		}
+		if (cache)
+			cache->store(entry.vsSource.c_str(), entry.fsSource.c_str(), entry.program);
+		*entry.target = ShaderProgram(entry.program);
+	}
+	pending.clear();
+	return succeeded;
+}
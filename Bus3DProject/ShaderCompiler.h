@@ -0,0 +1,43 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "ProgramCache.h"
+#include "ShaderProgram.h"
+
+// Kompajliranje svih programa odjednom: submit() samo predaje izvore drajveru
+// (glCompileShader/glLinkProgram bez citanja statusa) i odmah se vraca, pa se
+// kompajliranje preklapa sa ostatkom inicijalizacije. Sa KHR/ARB_parallel_shader_compile
+// drajver kompajlira na svojim nitima, a ready() proverava GL_COMPLETION_STATUS
+// bez blokiranja. finish() tek na kraju cita statuse i logove i popunjava programe.
+class ShaderCompiler {
+public:
+	// Posle pravljenja GL konteksta; cache moze da bude nullptr
+	void begin(ProgramCache* programCache);
+
+	// Rezultat se upisuje u *target u finish(); name je za poruke o greskama
+	void submit(const char* name, const std::string& vsSource, const std::string& fsSource, ShaderProgram* target);
+	// Da li su svi predati programi gotovi; bez parallel_shader_compile uvek true
+	bool ready() const;
+	// Ceka preostale programe i ispisuje logove; false ako neki program nije ispravan
+	bool finish();
+
+	bool parallel() const { return parallelCompile; }
+	int hits = 0;
+	int misses = 0;
+
+private:
+	struct Pending {
+		std::string name;
+		std::string vsSource;
+		std::string fsSource;
+		ShaderProgram* target;
+		unsigned int program;
+		unsigned int vs;
+		unsigned int fs;
+		bool fromCache;
+	};
+
+	std::vector<Pending> pending;
+	ProgramCache* cache = nullptr;
+	bool parallelCompile = false;
+};
@@ -0,0 +1,30 @@
+#include "ShaderProgram.h"
+#include <iostream>
+
+ShaderProgram::ShaderProgram(unsigned int program) : program(program) {
+	int count = 0, maxLength = 0;
+	glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+	glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+	std::vector<char> name(maxLength > 0 ? maxLength : 1);
+	for (int i = 0; i < count; ++i) {
+		int length = 0, size = 0;
+		GLenum type;
+		glGetActiveUniform(program, (GLuint)i, (GLsizei)name.size(), &length, &size, &type, name.data());
+		std::string uniformName(name.data(), length);
+		// Nizovi se prijavljuju kao "ime[0]", a traze se po imenu
+		if (uniformName.size() > 3 && uniformName.compare(uniformName.size() - 3, 3, "[0]") == 0)
+			uniformName.resize(uniformName.size() - 3);
+		int location = glGetUniformLocation(program, uniformName.c_str());
+		// Uniforme iz blokova nemaju lokaciju
+		if (location >= 0)
+			uniforms.push_back({ uniformName, location });
+	}
+}
+
+int ShaderProgram::uniform(const char* name) const {
+	for (const Uniform& u : uniforms) {
+		if (u.name == name) return u.location;
+	}
+	std::cout << "Uniforma " << name << " nije aktivna u programu " << program << std::endl;
+	return -1;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <string>
+#include <vector>
+
+// Linkovan program sa lokacijama svih aktivnih uniformi, procitanim jednom
+// (glGetActiveUniform) odmah posle linkovanja. Lokacije se uzimaju sa uniform()
+// pri inicijalizaciji i cuvaju, tako da se u petlji ne trazi nista po imenu.
+class ShaderProgram {
+public:
+	ShaderProgram() = default;
+	// Preuzima vec linkovan program
+	explicit ShaderProgram(unsigned int program);
+
+	unsigned int id() const { return program; }
+	void use() const { glUseProgram(program); }
+
+	// Lokacija aktivne uniforme, -1 ako ne postoji (ili ju je kompajler izbacio)
+	int uniform(const char* name) const;
+
+	// Postavljaju uniformu programa koji je trenutno u upotrebi (use())
+	void setInt(int location, int value) const { glUniform1i(location, value); }
+	void setFloat(int location, float value) const { glUniform1f(location, value); }
+	void setVec2(int location, const glm::vec2& v) const { glUniform2f(location, v.x, v.y); }
+	void setVec3(int location, const glm::vec3& v) const { glUniform3f(location, v.x, v.y, v.z); }
+	void setVec4(int location, const glm::vec4& v) const { glUniform4f(location, v.x, v.y, v.z, v.w); }
+	void setMat4(int location, const glm::mat4& m) const { glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(m)); }
+	// Niz uniformi (npr. mat4 model[2]); location je lokacija elementa [0]
+	void setMat4Array(int location, const glm::mat4* m, int count) const { glUniformMatrix4fv(location, count, GL_FALSE, glm::value_ptr(m[0])); }
+
+private:
+	struct Uniform {
+		std::string name;
+		int location;
+	};
+
+	unsigned int program = 0;
+	std::vector<Uniform> uniforms;
+};
@@ -0,0 +1,65 @@
+#include "SpriteAtlasLoader.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+SpriteAtlasLoader::~SpriteAtlasLoader() {
+	finish();
+}
+
+void SpriteAtlasLoader::start(const char* cookedPath) {
+	done.store(false, std::memory_order_relaxed);
+	worker = std::thread(&SpriteAtlasLoader::run, this, cookedPath);
+}
+
+void SpriteAtlasLoader::finish() {
+	if (worker.joinable())
+		worker.join();
+}
+
+void SpriteAtlasLoader::release() {
+	levels.clear();
+	mips.clear();
+	cooked = CookedAtlas();
+}
+
+void SpriteAtlasLoader::run(const char* cookedPath) {
+	auto start = std::chrono::steady_clock::now();
+	fromCooked = cookedPath && loadCookedAtlas(cookedPath, cooked);
+	if (fromCooked && cooked.spriteCount != SPRITE_COUNT) {
+		std::cout << "Atlas " << cookedPath << " ima " << cooked.spriteCount << " slika umesto " << SPRITE_COUNT << std::endl;
+		fromCooked = false;
+	}
+	// Izmenjene slike ili postavke atlasa znace ponovno dekodiranje
+	if (fromCooked && cooked.sourceHash != cookedAtlasSourceHash()) {
+		std::cout << "Atlas " << cookedPath << " je zastareo (izmenjene slike ili postavke atlasa), slike se dekodiraju" << std::endl;
+		fromCooked = false;
+	}
+	if (fromCooked) {
+		std::copy(cooked.regions, cooked.regions + SPRITE_COUNT, regions);
+		levels = cooked.levels;
+		// Citanje po jednog bajta sa svake stranice, da kopiranje u PBO na glavnoj niti ne ceka disk
+		volatile unsigned char sink = 0;
+		for (const AtlasLevel& level : levels) {
+			size_t bytes = 4 * (size_t)level.width * level.height;
+			for (size_t offset = 0; offset < bytes; offset += 4096)
+				sink = sink + level.pixels[offset];
+		}
+		succeeded = true;
+	}
+	else {
+		AtlasImage atlas;
+		std::vector<AtlasRegion> packed;
+		ThreadPool pool(std::min((int)std::thread::hardware_concurrency(), (int)SPRITE_COUNT));
+		succeeded = buildAtlas(SPRITE_FILES, SPRITE_COUNT, SPRITE_MAX_SIZE, ATLAS_PADDING, atlas, packed, nullptr, &pool);
+		if (succeeded) {
+			std::copy(packed.begin(), packed.end(), regions);
+			buildAtlasMips(atlas, ATLAS_MIP_LEVELS, mips);
+			for (const AtlasImage& mip : mips)
+				levels.push_back({ mip.width, mip.height, mip.pixels.data() });
+		}
+	}
+	seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	done.store(true, std::memory_order_release);
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "CookedAtlas.h"
+#include "TextureAtlas.h"
+
+// Priprema atlasa u pozadini, dok glavna nit pravi prozor i kompajlira sejdere.
+// Skuvan atlas se mapira (i stranice se ucitaju unapred), a bez njega se slike
+// dekodiraju paralelno na ThreadPool-u. Na glavnoj niti ostaje samo slanje na
+// GPU, kada ready() postane true. Posle release() moze ponovo da se pokrene.
+class SpriteAtlasLoader {
+public:
+	~SpriteAtlasLoader();
+
+	// cookedPath == nullptr preskace skuvan atlas i uvek dekodira slike iz res/
+	void start(const char* cookedPath);
+	bool ready() const { return done.load(std::memory_order_acquire); }
+	// Ceka kraj pozadinskog posla; posle toga su polja ispod vazeca
+	void finish();
+
+	bool succeeded = false;
+	bool fromCooked = false;
+	std::vector<AtlasLevel> levels;
+	AtlasRegion regions[SPRITE_COUNT];
+	double seconds = 0.0;
+
+	// Oslobadja piksele posle slanja na GPU
+	void release();
+
+private:
+	void run(const char* cookedPath);
+
+	std::thread worker;
+	std::atomic<bool> done{ false };
+	CookedAtlas cooked;
+	std::vector<AtlasImage> mips;
+};
@@ -0,0 +1,90 @@
+#include "SpriteBatch.h"
+#include <algorithm>
+
+void SpriteBatch::create() {
+	// Jedinicni kvadrat: pozicija, koordinate teksture
+	const float quad[] = { -0.5f, 0.5f, 0.0f, 1.0f, -0.5f, -0.5f, 0.0f, 0.0f, 0.5f, -0.5f, 1.0f, 0.0f, 0.5f, 0.5f, 1.0f, 1.0f };
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &quadVBO);
+	glGenBuffers(1, &instanceVBO);
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+	glEnableVertexAttribArray(1);
+	glEnableVertexAttribArray(2);
+	glVertexAttribDivisor(2, 1);
+	glEnableVertexAttribArray(3);
+	glVertexAttribDivisor(3, 1);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+}
+
+void SpriteBatch::destroy() {
+	glDeleteVertexArrays(1, &VAO);
+	glDeleteBuffers(1, &quadVBO);
+	glDeleteBuffers(1, &instanceVBO);
+	VAO = quadVBO = instanceVBO = 0;
+	instanceCapacity = 0;
+	sprites.clear();
+}
+
+void SpriteBatch::add(unsigned int texture, float x, float y, float scale, int layer,
+	float u0, float v0, float u1, float v1) {
+	sprites.push_back({ layer, texture, x, y, scale, u0, v0, u1, v1 });
+}
+
+// Bez baseInstance (GL 4.2) pocetak niza se zadaje pomerajem atributa
+void SpriteBatch::pointInstancesAt(size_t firstInstance) {
+	size_t stride = FLOATS_PER_INSTANCE * sizeof(float);
+	glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, (GLsizei)stride, (void*)(firstInstance * stride));
+	glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, (GLsizei)stride, (void*)(firstInstance * stride + 3 * sizeof(float)));
+}
+
+int SpriteBatch::flush(const ShaderProgram& shader) {
+	if (sprites.empty()) return 0;
+
+	// Stabilno, da pravougaonici sa istim kljucem ostanu u redosledu dodavanja
+	std::stable_sort(sprites.begin(), sprites.end(), [](const Sprite& a, const Sprite& b) {
+		return a.layer != b.layer ? a.layer < b.layer : a.texture < b.texture;
+	});
+
+	instances.resize(sprites.size() * FLOATS_PER_INSTANCE);
+	float* out = instances.data();
+	for (const Sprite& s : sprites) {
+		out[0] = s.x; out[1] = s.y; out[2] = s.scale;
+		out[3] = s.u0; out[4] = s.v0; out[5] = s.u1; out[6] = s.v1;
+		out += FLOATS_PER_INSTANCE;
+	}
+
+	// Bafer se "siroci" svaki frejm, pa drajver ne ceka da GPU zavrsi prethodni
+	glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+	size_t bytes = instances.size() * sizeof(float);
+	if (bytes > instanceCapacity)
+		instanceCapacity = std::max(bytes, 2 * instanceCapacity);
+	glBufferData(GL_ARRAY_BUFFER, instanceCapacity, NULL, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, instances.data());
+
+	shader.use();
+	glActiveTexture(GL_TEXTURE0);
+	glBindVertexArray(VAO);
+	int drawCalls = 0;
+	size_t first = 0;
+	while (first < sprites.size()) {
+		size_t last = first + 1;
+		// Susedni slojevi sa istom teksturom (npr. iz atlasa) idu u isti poziv
+		while (last < sprites.size() && sprites[last].texture == sprites[first].texture)
+			++last;
+		glBindTexture(GL_TEXTURE_2D, sprites[first].texture);
+		pointInstancesAt(first);
+		glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, 4, (GLsizei)(last - first));
+		drawCalls++;
+		first = last;
+	}
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	sprites.clear();
+	return drawCalls;
+}
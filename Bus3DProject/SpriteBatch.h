@@ -0,0 +1,41 @@
+#pragma once
+#include <vector>
+#include "ShaderProgram.h"
+
+// Skuplja teksturisane pravougaonike (pozicija, velicina, deo teksture) i crta
+// ih sa sto manje poziva: na flush() se sortiraju po sloju pa po teksturi, svi
+// podaci idu u jedan bafer po instanci, a svaki niz sa istom teksturom je jedan
+// glDrawArraysInstanced. Slojevi cuvaju redosled crtanja (npr. autobus preko
+// stanice); ako sve dolazi iz jedne teksture, ceo sloj ide u jedan poziv.
+class SpriteBatch {
+public:
+	void create();
+	void destroy();
+
+	// u0, v0, u1, v1: deo teksture (podrazumevano cela)
+	void add(unsigned int texture, float x, float y, float scale, int layer = 0,
+		float u0 = 0.0f, float v0 = 0.0f, float u1 = 1.0f, float v1 = 1.0f);
+	int size() const { return (int)sprites.size(); }
+
+	// Crta sve sto je dodato (shader: rect.vert) i prazni listu; vraca broj poziva crtanja
+	int flush(const ShaderProgram& shader);
+
+private:
+	struct Sprite {
+		int layer;
+		unsigned int texture;
+		float x, y, scale;
+		float u0, v0, u1, v1;
+	};
+
+	static const int FLOATS_PER_INSTANCE = 7;
+
+	std::vector<Sprite> sprites;
+	std::vector<float> instances;
+	unsigned int VAO = 0;
+	unsigned int quadVBO = 0;
+	unsigned int instanceVBO = 0;
+	size_t instanceCapacity = 0;
+
+	void pointInstancesAt(size_t firstInstance);
+};
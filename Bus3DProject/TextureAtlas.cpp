@@ -0,0 +1,303 @@
+#include "TextureAtlas.h"
+#include "ThreadPool.h"
+#include "stb_image.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+const char* const SPRITE_FILES[SPRITE_COUNT] = {
+	"res/avtobus.png",
+	"res/busstation.jpeg",
+	"res/zatvorena.png",
+	"res/otvorena.png",
+	"res/kontrola.png",
+	"res/ime.png",
+};
+
+// Ikonice mape su kvadrati stranice scale u NDC, tj. najvise scale * sirina / 2
+// piksela. Mapa prati visinu prozora (800x600 pri 800 piksela); velicine vaze do
+// mape 1600x1200, a na vecoj se slike blago uvecavaju. Slika u kabini moze da
+// zauzme veliki deo ekrana, pa za nju vazi samo ATLAS_MAX_SPRITE_SIZE.
+const int SPRITE_MAX_SIZE[SPRITE_COUNT] = {
+	200,                   // autobus, BUS_SCALE = 0.25
+	120,                   // stanica, STATION_SCALE = 0.15
+	160,                   // zatvorena vrata, 0.2
+	160,                   // otvorena vrata, 0.2
+	240,                   // kontrola karata, 0.3
+	ATLAS_MAX_SPRITE_SIZE, // slika u kabini
+};
+
+void SkylinePacker::reset(int width, int height) {
+	atlasWidth = width;
+	atlasHeight = height;
+	skyline.assign(1, { 0, 0, width });
+}
+
+int SkylinePacker::fitAt(size_t index, int width, int height) const {
+	int x = skyline[index].x;
+	if (x + width > atlasWidth) return -1;
+	int y = 0;
+	int remaining = width;
+	for (size_t i = index; remaining > 0; ++i) {
+		y = std::max(y, skyline[i].y);
+		if (y + height > atlasHeight) return -1;
+		remaining -= skyline[i].width;
+	}
+	return y;
+}
+
+bool SkylinePacker::insert(int width, int height, int& x, int& y) {
+	int bestTop = atlasHeight + 1, bestWidth = 0;
+	size_t bestIndex = skyline.size();
+	for (size_t i = 0; i < skyline.size(); ++i) {
+		int fitY = fitAt(i, width, height);
+		if (fitY < 0) continue;
+		int top = fitY + height;
+		if (top < bestTop || (top == bestTop && skyline[i].width < bestWidth)) {
+			bestTop = top;
+			bestWidth = skyline[i].width;
+			bestIndex = i;
+			y = fitY;
+		}
+	}
+	if (bestIndex == skyline.size()) return false;
+	x = skyline[bestIndex].x;
+
+	// Novi segment pokriva [x, x + width), segmenti ispod se skracuju ili brisu
+	skyline.insert(skyline.begin() + bestIndex, { x, y + height, width });
+	for (size_t i = bestIndex + 1; i < skyline.size();) {
+		int covered = x + width - skyline[i].x;
+		if (covered <= 0) break;
+		if (covered < skyline[i].width) {
+			skyline[i].x += covered;
+			skyline[i].width -= covered;
+			break;
+		}
+		skyline.erase(skyline.begin() + i);
+	}
+	// Spajanje susednih segmenata iste visine
+	for (size_t i = 0; i + 1 < skyline.size();) {
+		if (skyline[i].y == skyline[i + 1].y) {
+			skyline[i].width += skyline[i + 1].width;
+			skyline.erase(skyline.begin() + i + 1);
+		}
+		else {
+			++i;
+		}
+	}
+	return true;
+}
+
+namespace {
+
+struct SourceImage {
+	int width = 1;
+	int height = 1;
+	std::vector<unsigned char> pixels = std::vector<unsigned char>(4, 255);
+};
+
+// Umanjivanje uprosecavanjem piksela koji padaju u isti izlazni piksel
+void downscale(SourceImage& image, int maxSize) {
+	int largest = std::max(image.width, image.height);
+	if (largest <= maxSize) return;
+	int width = std::max(1, image.width * maxSize / largest);
+	int height = std::max(1, image.height * maxSize / largest);
+	std::vector<unsigned char> pixels(4 * (size_t)width * height);
+	for (int y = 0; y < height; ++y) {
+		int y0 = y * image.height / height, y1 = std::max(y0 + 1, (y + 1) * image.height / height);
+		for (int x = 0; x < width; ++x) {
+			int x0 = x * image.width / width, x1 = std::max(x0 + 1, (x + 1) * image.width / width);
+			unsigned int sum[4] = { 0, 0, 0, 0 };
+			for (int sy = y0; sy < y1; ++sy)
+				for (int sx = x0; sx < x1; ++sx)
+					for (int c = 0; c < 4; ++c)
+						sum[c] += image.pixels[4 * ((size_t)sy * image.width + sx) + c];
+			unsigned int samples = (unsigned int)((y1 - y0) * (x1 - x0));
+			for (int c = 0; c < 4; ++c)
+				pixels[4 * ((size_t)y * width + x) + c] = (unsigned char)(sum[c] / samples);
+		}
+	}
+	image.width = width;
+	image.height = height;
+	image.pixels.swap(pixels);
+}
+
+// Kopira sliku na (x, y) i ponavlja ivicne piksele u okviru sirine padding
+void blitWithPadding(AtlasImage& atlas, const SourceImage& image, int x, int y, int padding) {
+	for (int row = -padding; row < image.height + padding; ++row) {
+		int sourceRow = std::clamp(row, 0, image.height - 1);
+		for (int column = -padding; column < image.width + padding; ++column) {
+			int sourceColumn = std::clamp(column, 0, image.width - 1);
+			const unsigned char* source = &image.pixels[4 * ((size_t)sourceRow * image.width + sourceColumn)];
+			unsigned char* target = &atlas.pixels[4 * ((size_t)(y + row) * atlas.width + (x + column))];
+			std::copy(source, source + 4, target);
+		}
+	}
+}
+
+}
+
+// Velicina sa okvirom, zaokruzena na ATLAS_ALIGNMENT
+static int alignedSize(int size, int padding) {
+	return (size + 2 * padding + ATLAS_ALIGNMENT - 1) / ATLAS_ALIGNMENT * ATLAS_ALIGNMENT;
+}
+
+bool buildAtlas(const char* const* files, int count, const int* maxSpriteSizes, int padding,
+	AtlasImage& atlas, std::vector<AtlasRegion>& regions, size_t* sourceTextureBytes, ThreadPool* pool) {
+	std::vector<SourceImage> images(count);
+	std::vector<size_t> sourceBytes(count, 0);
+	auto decode = [&](int begin, int end) {
+		// Isto kao loadImageToTexture: prvi red podataka je dno slike. Globalni
+		// prekidac bi se menjao iz vise niti, pa se postavlja za svaku nit posebno.
+		stbi_set_flip_vertically_on_load_thread(true);
+		for (int i = begin; i < end; ++i) {
+			int width, height, channels;
+			unsigned char* data = stbi_load(files[i], &width, &height, &channels, 4);
+			if (!data) {
+				std::cout << "Neuspešno učitavanje teksture: " << files[i] << std::endl;
+				continue;
+			}
+			images[i].width = width;
+			images[i].height = height;
+			images[i].pixels.assign(data, data + 4 * (size_t)width * height);
+			stbi_image_free(data);
+			// Pun mip lanac je oko 4/3 osnovnog nivoa
+			sourceBytes[i] = 4 * (size_t)width * height * 4 / 3;
+			downscale(images[i], maxSpriteSizes[i]);
+		}
+	};
+	// Svaka slika je poseban deo posla
+	if (pool)
+		pool->parallelFor(count, 1, decode);
+	else
+		decode(0, count);
+	if (sourceTextureBytes) {
+		*sourceTextureBytes = 0;
+		for (size_t bytes : sourceBytes) *sourceTextureBytes += bytes;
+	}
+
+	// Visoke slike prve, tako skyline ostaje ravniji
+	std::vector<int> order(count);
+	for (int i = 0; i < count; ++i) order[i] = i;
+	std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return images[a].height > images[b].height; });
+
+	// Atlas raste (naizmenicno sirina pa visina) dok sve ne stane
+	const int MAX_ATLAS_SIZE = 8192;
+	int width = 256, height = 256;
+	std::vector<int> placedX(count), placedY(count);
+	SkylinePacker packer;
+	while (true) {
+		packer.reset(width, height);
+		bool fits = true;
+		for (int i : order) {
+			if (!packer.insert(alignedSize(images[i].width, padding), alignedSize(images[i].height, padding), placedX[i], placedY[i])) {
+				fits = false;
+				break;
+			}
+		}
+		if (fits) break;
+		if (width >= MAX_ATLAS_SIZE && height >= MAX_ATLAS_SIZE) {
+			std::cout << "Slike ne staju u atlas " << MAX_ATLAS_SIZE << "x" << MAX_ATLAS_SIZE << std::endl;
+			return false;
+		}
+		if (width <= height) width *= 2; else height *= 2;
+	}
+
+	atlas.width = width;
+	atlas.height = height;
+	atlas.pixels.assign(4 * (size_t)width * height, 0);
+	regions.assign(count, AtlasRegion());
+	for (int i = 0; i < count; ++i) {
+		AtlasRegion& region = regions[i];
+		region.x = placedX[i] + padding;
+		region.y = placedY[i] + padding;
+		region.width = images[i].width;
+		region.height = images[i].height;
+		region.u0 = (float)region.x / width;
+		region.v0 = (float)region.y / height;
+		region.u1 = (float)(region.x + region.width) / width;
+		region.v1 = (float)(region.y + region.height) / height;
+		blitWithPadding(atlas, images[i], region.x, region.y, padding);
+	}
+	return true;
+}
+
+void buildAtlasMips(const AtlasImage& atlas, int levels, std::vector<AtlasImage>& mips) {
+	mips.assign(1, atlas);
+	for (int level = 1; level < levels; ++level) {
+		const AtlasImage& previous = mips.back();
+		if (previous.width == 1 && previous.height == 1) break;
+		AtlasImage next;
+		next.width = std::max(1, previous.width / 2);
+		next.height = std::max(1, previous.height / 2);
+		next.pixels.resize(4 * (size_t)next.width * next.height);
+		for (int y = 0; y < next.height; ++y) {
+			int y0 = std::min(2 * y, previous.height - 1), y1 = std::min(2 * y + 1, previous.height - 1);
+			for (int x = 0; x < next.width; ++x) {
+				int x0 = std::min(2 * x, previous.width - 1), x1 = std::min(2 * x + 1, previous.width - 1);
+				for (int c = 0; c < 4; ++c) {
+					unsigned int sum = previous.pixels[4 * ((size_t)y0 * previous.width + x0) + c] +
+						previous.pixels[4 * ((size_t)y0 * previous.width + x1) + c] +
+						previous.pixels[4 * ((size_t)y1 * previous.width + x0) + c] +
+						previous.pixels[4 * ((size_t)y1 * previous.width + x1) + c];
+					next.pixels[4 * ((size_t)y * next.width + x) + c] = (unsigned char)((sum + 2) / 4);
+				}
+			}
+		}
+		mips.push_back(std::move(next));
+	}
+}
+
+size_t mipChainBytes(const std::vector<AtlasLevel>& levels) {
+	size_t bytes = 0;
+	for (const AtlasLevel& level : levels)
+		bytes += 4 * (size_t)level.width * level.height;
+	return bytes;
+}
+
+bool writeAtlasTga(const char* filePath, const AtlasImage& atlas) {
+	FILE* file = fopen(filePath, "wb");
+	if (!file) {
+		std::cout << "Ne moze da se otvori fajl za upis: " << filePath << std::endl;
+		return false;
+	}
+	// Nekompresovan truecolor, poreklo dole levo, 8 bita alfe
+	unsigned char header[18] = {};
+	header[2] = 2;
+	header[12] = (unsigned char)(atlas.width & 0xFF);
+	header[13] = (unsigned char)(atlas.width >> 8);
+	header[14] = (unsigned char)(atlas.height & 0xFF);
+	header[15] = (unsigned char)(atlas.height >> 8);
+	header[16] = 32;
+	header[17] = 8;
+	std::vector<unsigned char> bgra(atlas.pixels.size());
+	for (size_t i = 0; i < atlas.pixels.size(); i += 4) {
+		bgra[i] = atlas.pixels[i + 2];
+		bgra[i + 1] = atlas.pixels[i + 1];
+		bgra[i + 2] = atlas.pixels[i];
+		bgra[i + 3] = atlas.pixels[i + 3];
+	}
+	bool written = fwrite(header, 1, sizeof(header), file) == sizeof(header) &&
+		fwrite(bgra.data(), 1, bgra.size(), file) == bgra.size();
+	written = (fclose(file) == 0) && written;
+	if (!written)
+		std::cout << "Greska pri upisu fajla: " << filePath << std::endl;
+	return written;
+}
+
+bool writeAtlasTable(const char* filePath, const char* const* names, const std::vector<AtlasRegion>& regions) {
+	FILE* file = fopen(filePath, "w");
+	if (!file) {
+		std::cout << "Ne moze da se otvori fajl za upis: " << filePath << std::endl;
+		return false;
+	}
+	fprintf(file, "# ime x y sirina visina u0 v0 u1 v1\n");
+	for (size_t i = 0; i < regions.size(); ++i) {
+		const AtlasRegion& r = regions[i];
+		fprintf(file, "%s %d %d %d %d %.6f %.6f %.6f %.6f\n", names[i], r.x, r.y, r.width, r.height, r.u0, r.v0, r.u1, r.v1);
+	}
+	bool written = fclose(file) == 0;
+	if (!written)
+		std::cout << "Greska pri upisu fajla: " << filePath << std::endl;
+	return written;
+}
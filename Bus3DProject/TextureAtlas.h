@@ -0,0 +1,89 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+class ThreadPool;
+
+// Sve 2D slike (mapa, ikonice, slika u kabini) u jednoj RGBA8 teksturi, da bi
+// SpriteBatch mogao sve da nacrta jednim pozivom. Slike se pri pakovanju
+// umanjuju na najvise maxSpriteSizes[i] piksela po strani, a oko svake se ivicni
+// pikseli ponavljaju padding puta, pa linearno filtriranje ne "curi" u susede.
+// Redovi su odozdo nagore (kao u OpenGL teksturi), v = 0 je dno atlasa.
+
+enum SpriteId {
+	SPRITE_BUS,
+	SPRITE_STATION,
+	SPRITE_DOOR_CLOSED,
+	SPRITE_DOOR_OPEN,
+	SPRITE_CONTROL,
+	SPRITE_IME,
+	SPRITE_COUNT
+};
+
+// Fajlovi iz res/ po SpriteId
+extern const char* const SPRITE_FILES[SPRITE_COUNT];
+
+// Broj nivoa mip lanca. Okvir od ATLAS_PADDING piksela se na poslednjem nivou
+// svodi na jedan piksel, a pravougaonici su poravnati na 1 << (nivoi - 1), pa
+// se ni na jednom nivou slike ne mesaju.
+const int ATLAS_MIP_LEVELS = 4;
+const int ATLAS_PADDING = 8;
+const int ATLAS_ALIGNMENT = 1 << (ATLAS_MIP_LEVELS - 1);
+// 496 + 2 * ATLAS_PADDING = 512, pa cetiri najvece slike staju u red atlasa sirine 2048
+const int ATLAS_MAX_SPRITE_SIZE = 496;
+// Najveca strana svake slike po SpriteId, prema najvecoj velicini na ekranu
+extern const int SPRITE_MAX_SIZE[SPRITE_COUNT];
+
+struct AtlasRegion {
+	int x = 0, y = 0, width = 0, height = 0; // bez okvira
+	float u0 = 0.0f, v0 = 0.0f, u1 = 0.0f, v1 = 0.0f;
+};
+
+struct AtlasImage {
+	int width = 0;
+	int height = 0;
+	std::vector<unsigned char> pixels; // RGBA8
+};
+
+// Jedan nivo mip lanca za slanje na GPU; pikseli mogu biti i u mapiranom fajlu
+struct AtlasLevel {
+	int width;
+	int height;
+	const unsigned char* pixels;
+};
+
+// Skyline pakovanje (bottom-left): gornja ivica zauzetog prostora se pamti kao
+// niz vodoravnih segmenata, a pravougaonik ide tamo gde mu je gornja ivica najniza.
+class SkylinePacker {
+public:
+	void reset(int atlasWidth, int atlasHeight);
+	bool insert(int width, int height, int& x, int& y);
+
+private:
+	struct Node {
+		int x, y, width;
+	};
+
+	int atlasWidth = 0;
+	int atlasHeight = 0;
+	std::vector<Node> skyline;
+
+	// Najmanja visina na kojoj pravougaonik sirine width staje pocevsi od cvora index, -1 ako ne staje
+	int fitAt(size_t index, int width, int height) const;
+};
+
+// Ucitava count slika i pakuje ih; za sliku koja ne moze da se ucita ostaje beli pravougaonik.
+// sourceTextureBytes (ako nije nullptr) dobija memoriju koju bi zauzele zasebne
+// teksture u punoj rezoluciji sa mipovima, za poredjenje. Sa pool-om se slike
+// dekodiraju i umanjuju paralelno.
+bool buildAtlas(const char* const* files, int count, const int* maxSpriteSizes, int padding,
+	AtlasImage& atlas, std::vector<AtlasRegion>& regions, size_t* sourceTextureBytes = nullptr,
+	ThreadPool* pool = nullptr);
+
+// Nivoi 1..levels-1 uprosecavanjem 2x2 piksela (mips[0] je kopija atlasa)
+void buildAtlasMips(const AtlasImage& atlas, int levels, std::vector<AtlasImage>& mips);
+size_t mipChainBytes(const std::vector<AtlasLevel>& levels);
+
+// Offline izlaz: atlas kao 32-bitni TGA i tabela "ime x y sirina visina u0 v0 u1 v1"
+bool writeAtlasTga(const char* filePath, const AtlasImage& atlas);
+bool writeAtlasTable(const char* filePath, const char* const* names, const std::vector<AtlasRegion>& regions);
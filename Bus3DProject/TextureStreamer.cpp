@@ -0,0 +1,135 @@
+#include "TextureStreamer.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+void TextureStreamer::create(size_t newSlotBytes, int slotCount) {
+	slotBytes = newSlotBytes;
+	slots.assign(slotCount, Slot());
+	nextSlot = 0;
+
+	if (GLEW_ARB_buffer_storage) {
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glGenBuffers(1, &persistentBuffer);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, persistentBuffer);
+		glBufferStorage(GL_PIXEL_UNPACK_BUFFER, slotBytes * slotCount, nullptr, flags);
+		mapped = (unsigned char*)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, slotBytes * slotCount, flags);
+		if (!mapped) {
+			glDeleteBuffers(1, &persistentBuffer);
+			persistentBuffer = 0;
+		}
+	}
+	if (!mapped) {
+		for (Slot& slot : slots) {
+			glGenBuffers(1, &slot.buffer);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+			glBufferData(GL_PIXEL_UNPACK_BUFFER, slotBytes, nullptr, GL_STREAM_DRAW);
+		}
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+void TextureStreamer::destroy() {
+	for (Upload& upload : uploads)
+		glDeleteTextures(1, &upload.texture);
+	uploads.clear();
+	for (Slot& slot : slots) {
+		if (slot.fence)
+			glDeleteSync(slot.fence);
+		if (slot.buffer)
+			glDeleteBuffers(1, &slot.buffer);
+	}
+	slots.clear();
+	if (persistentBuffer) {
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, persistentBuffer);
+		glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		glDeleteBuffers(1, &persistentBuffer);
+		persistentBuffer = 0;
+	}
+	mapped = nullptr;
+}
+
+void TextureStreamer::queue(unsigned int texture, const std::vector<AtlasLevel>& levels, std::function<void(unsigned int texture)> onReady) {
+	if (levels.empty()) {
+		if (onReady)
+			onReady(texture);
+		return;
+	}
+	Upload upload;
+	upload.texture = texture;
+	upload.levels = levels;
+	upload.onReady = std::move(onReady);
+	uploads.push_back(std::move(upload));
+}
+
+size_t TextureStreamer::update(size_t budgetBytes) {
+	size_t sent = 0;
+	while (!uploads.empty() && sent < budgetBytes) {
+		Upload& upload = uploads.front();
+		const AtlasLevel& level = upload.levels[upload.level];
+		size_t rowBytes = 4 * (size_t)level.width;
+		size_t room = std::min(slotBytes, budgetBytes - sent);
+		int rows = std::min(level.height - upload.row, std::max(1, (int)(room / rowBytes)));
+		size_t bytes = rows * rowBytes;
+		const unsigned char* source = level.pixels + upload.row * rowBytes;
+
+		Slot& slot = slots[nextSlot];
+		size_t offset = 0;
+		if (bytes > slotBytes) {
+			// Red siri od slota (ne desava se za atlas do 8192 piksela); salje se direktno
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			offset = (size_t)source;
+		}
+		else if (mapped) {
+			if (slot.fence) {
+				// GPU jos cita ovaj slot; bez cekanja, slanje se nastavlja u sledecem frejmu
+				if (glClientWaitSync(slot.fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+					break;
+				glDeleteSync(slot.fence);
+				slot.fence = nullptr;
+			}
+			offset = nextSlot * slotBytes;
+			memcpy(mapped + offset, source, bytes);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, persistentBuffer);
+		}
+		else {
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.buffer);
+			glBufferData(GL_PIXEL_UNPACK_BUFFER, slotBytes, nullptr, GL_STREAM_DRAW);
+			void* target = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+			if (target) {
+				memcpy(target, source, bytes);
+				glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+			}
+			else {
+				// Mapiranje nije uspelo; ovi redovi idu direktno iz memorije procesa
+				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+				offset = (size_t)source;
+			}
+		}
+		glBindTexture(GL_TEXTURE_2D, upload.texture);
+		glTexSubImage2D(GL_TEXTURE_2D, upload.level, 0, upload.row, level.width, rows, GL_RGBA, GL_UNSIGNED_BYTE, (void*)(uintptr_t)offset);
+		if (mapped && bytes <= slotBytes)
+			slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		nextSlot = (nextSlot + 1) % (int)slots.size();
+		sent += bytes;
+
+		upload.row += rows;
+		if (upload.row == level.height) {
+			upload.level++;
+			upload.row = 0;
+		}
+		if (upload.level == (int)upload.levels.size()) {
+			// Sve komande za teksturu su poslate; naredna crtanja je vide celu
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			glBindTexture(GL_TEXTURE_2D, 0);
+			Upload done = std::move(upload);
+			uploads.pop_front();
+			if (done.onReady)
+				done.onReady(done.texture);
+		}
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	return sent;
+}
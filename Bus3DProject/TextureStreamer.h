@@ -0,0 +1,50 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <vector>
+#include "TextureAtlas.h"
+
+// Slanje tekstura kroz prsten pixel buffer objekata (GL_PIXEL_UNPACK_BUFFER).
+// U svakom frejmu se najvise budgetBytes piksela kopira u sledeci slot prstena,
+// a glTexSubImage2D cita iz PBO-a i odmah se vraca, pa se prenos na GPU odvija
+// dok CPU priprema sledeci frejm. Sa ARB_buffer_storage bafer je trajno mapiran
+// i slot se ponovo koristi tek kada njegov fence prodje; bez njega se svaki slot
+// pre upisa "sirocuje" (glBufferData sa nullptr).
+class TextureStreamer {
+public:
+	void create(size_t newSlotBytes, int slotCount);
+	void destroy();
+
+	// Tekstura mora vec da ima prostor za sve nivoe (glTexImage2D sa nullptr).
+	// Pikseli moraju da postoje dok se ne pozove onReady; posle toga tekstura
+	// moze da se crta, a stara da se obrise.
+	void queue(unsigned int texture, const std::vector<AtlasLevel>& levels, std::function<void(unsigned int texture)> onReady);
+	// Salje sledece redove tekstura iz reda; vraca broj poslatih bajtova
+	size_t update(size_t budgetBytes);
+
+	bool busy() const { return !uploads.empty(); }
+	bool persistent() const { return mapped != nullptr; }
+
+private:
+	struct Upload {
+		unsigned int texture = 0;
+		std::vector<AtlasLevel> levels;
+		std::function<void(unsigned int)> onReady;
+		int level = 0;
+		int row = 0;
+	};
+	struct Slot {
+		unsigned int buffer = 0;
+		GLsync fence = nullptr;
+	};
+
+	std::vector<Slot> slots;
+	std::deque<Upload> uploads;
+	size_t slotBytes = 0;
+	int nextSlot = 0;
+	// Trajno mapiran bafer za sve slotove (samo sa ARB_buffer_storage)
+	unsigned int persistentBuffer = 0;
+	unsigned char* mapped = nullptr;
+};
@@ -0,0 +1,101 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(int threadCount) {
+	if (threadCount <= 0)
+		threadCount = std::max(1, (int)std::thread::hardware_concurrency());
+	for (int i = 0; i < threadCount; ++i)
+		queues.push_back(std::make_unique<WorkQueue>());
+	for (int i = 1; i < threadCount; ++i)
+		workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(jobMutex);
+		stopping = true;
+	}
+	jobReady.notify_all();
+	for (std::thread& worker : workers)
+		worker.join();
+}
+
+void ThreadPool::workerLoop(int index) {
+	unsigned long long seenGeneration = 0;
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock(jobMutex);
+			jobReady.wait(lock, [&] { return stopping || generation != seenGeneration; });
+			if (stopping) return;
+			seenGeneration = generation;
+		}
+		while (runOneChunk(index)) {}
+	}
+}
+
+bool ThreadPool::runOneChunk(int index) {
+	int chunk = -1;
+	{
+		// Sopstveni red se prazni od pocetka (susedni delovi, bolja lokalnost)
+		WorkQueue& own = *queues[index];
+		std::lock_guard<std::mutex> lock(own.mutex);
+		if (!own.chunks.empty()) {
+			chunk = own.chunks.front();
+			own.chunks.pop_front();
+		}
+	}
+	for (int offset = 1; chunk < 0 && offset < (int)queues.size(); ++offset) {
+		// Kradja sa kraja tudjeg reda
+		WorkQueue& victim = *queues[(index + offset) % queues.size()];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.chunks.empty()) {
+			chunk = victim.chunks.back();
+			victim.chunks.pop_back();
+		}
+	}
+	if (chunk < 0) return false;
+
+	int begin = chunk * jobChunkSize;
+	int end = std::min(begin + jobChunkSize, jobCount);
+	(*jobBody)(begin, end);
+
+	if (remainingChunks.fetch_sub(1) == 1) {
+		std::lock_guard<std::mutex> lock(jobMutex);
+		jobDone.notify_all();
+	}
+	return true;
+}
+
+void ThreadPool::parallelFor(int count, int chunkSize, const std::function<void(int, int)>& body) {
+	if (count <= 0) return;
+	int numChunks = (count + chunkSize - 1) / chunkSize;
+	if (queues.size() == 1 || numChunks == 1) {
+		for (int begin = 0; begin < count; begin += chunkSize)
+			body(begin, std::min(begin + chunkSize, count));
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(jobMutex);
+		jobBody = &body;
+		jobCount = count;
+		jobChunkSize = chunkSize;
+		remainingChunks = numChunks;
+
+		// Svaka nit dobija neprekidan niz delova
+		int numQueues = (int)queues.size();
+		for (int q = 0; q < numQueues; ++q) {
+			WorkQueue& queue = *queues[q];
+			std::lock_guard<std::mutex> queueLock(queue.mutex);
+			for (int chunk = numChunks * q / numQueues; chunk < numChunks * (q + 1) / numQueues; ++chunk)
+				queue.chunks.push_back(chunk);
+		}
+		generation++;
+	}
+	jobReady.notify_all();
+
+	while (runOneChunk(0)) {}
+
+	std::unique_lock<std::mutex> lock(jobMutex);
+	jobDone.wait(lock, [&] { return remainingChunks.load() == 0; });
+}
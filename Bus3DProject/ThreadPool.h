@@ -0,0 +1,50 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Thread pool sa kradjom posla (work stealing). Posao se deli na delove fiksne
+// velicine; svaka nit prvo obradjuje svoj red, a kada ga isprazni krade delove
+// sa kraja tudjih redova. Pozivajuca nit ucestvuje kao nit 0.
+class ThreadPool {
+public:
+	// threadCount <= 0 znaci broj jezgara
+	explicit ThreadPool(int threadCount = 0);
+	~ThreadPool();
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	int threadCount() const { return (int)queues.size(); }
+
+	// Poziva body(begin, end) za svaki deo [0, count) velicine chunkSize i ceka da se svi zavrse.
+	// Granice delova ne zavise od broja niti.
+	void parallelFor(int count, int chunkSize, const std::function<void(int, int)>& body);
+
+private:
+	struct WorkQueue {
+		std::mutex mutex;
+		std::deque<int> chunks;
+	};
+
+	void workerLoop(int index);
+	bool runOneChunk(int index);
+
+	std::vector<std::thread> workers;
+	std::vector<std::unique_ptr<WorkQueue>> queues;
+
+	std::mutex jobMutex;
+	std::condition_variable jobReady;
+	std::condition_variable jobDone;
+	unsigned long long generation = 0;
+	bool stopping = false;
+
+	const std::function<void(int, int)>* jobBody = nullptr;
+	int jobCount = 0;
+	int jobChunkSize = 0;
+	std::atomic<int> remainingChunks{ 0 };
+};
@@ -1,4 +1,5 @@
 #include "Util.h"
+#include "ShaderCompiler.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -13,25 +14,12 @@ std::string readFile(const char* filePath) {
     return buffer.str();
 }
 
-unsigned int createShader(const char* vsSource, const char* fsSource) {
-    unsigned int program = glCreateProgram();
-    unsigned int vs = glCreateShader(GL_VERTEX_SHADER);
-    unsigned int fs = glCreateShader(GL_FRAGMENT_SHADER);
-
-    glShaderSource(vs, 1, &vsSource, NULL);
-    glCompileShader(vs);
-
-    glShaderSource(fs, 1, &fsSource, NULL);
-    glCompileShader(fs);
-
-    glAttachShader(program, vs);
-    glAttachShader(program, fs);
-    glLinkProgram(program);
-    glValidateProgram(program);
-
-    glDeleteShader(vs);
-    glDeleteShader(fs);
-
+ShaderProgram createShader(const char* vsSource, const char* fsSource) {
+    ShaderProgram program;
+    ShaderCompiler compiler;
+    compiler.begin(nullptr);
+    compiler.submit("createShader", vsSource, fsSource, &program);
+    compiler.finish();
     return program;
 }
 
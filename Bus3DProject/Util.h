@@ -2,8 +2,10 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <string>
+#include "ShaderProgram.h"
 
-unsigned int createShader(const char* vsSource, const char* fsSource);
+// Jedan program, sinhrono; za vise programa odjednom vidi ShaderCompiler.h
+ShaderProgram createShader(const char* vsSource, const char* fsSource);
 unsigned int loadImageToTexture(const char* filePath);
 GLFWcursor* loadImageToCursor(const char* filePath);
 std::string readFile(const char* filePath); // Pomoćna funkcija za čitanje fajlova
\ No newline at end of file
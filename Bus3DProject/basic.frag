@@ -1,8 +1,7 @@
 #version 330 core
+in vec4 Color;
 out vec4 FragColor;
-uniform vec3 color;
-uniform float alpha;
 
 void main() {
-    FragColor = vec4(color, alpha);
+    FragColor = Color;
 }
\ No newline at end of file
@@ -1,10 +1,20 @@
 #version 330 core
 layout (location = 0) in vec3 aPos;
+// Boja i providnost su zapecene u temena (ColoredMesh.h)
+layout (location = 1) in vec4 aColor;
+layout (location = 2) in float aPart;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+out vec4 Color;
+
+// model[0]: staticna kabina, model[1]: vrata
+uniform mat4 model[2];
+// Zajednicko za sve programe, puni se jednom po frejmu (CameraBuffer.h)
+layout (std140) uniform Camera {
+    mat4 projection;
+    mat4 view;
+};
 
 void main() {
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
+    gl_Position = projection * view * model[int(aPart)] * vec4(aPos, 1.0);
+    Color = aColor;
 }
\ No newline at end of file
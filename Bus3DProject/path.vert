@@ -0,0 +1,35 @@
+#version 330 core
+// Debela linija: svaka tacka putanje je u baferu dvaput (jedno teme za svaku
+// ivicu trake), a prethodna i sledeca tacka se citaju iz istog bafera sa pomerajem.
+layout (location = 0) in vec2 aPrev;
+layout (location = 1) in vec2 aPos;
+layout (location = 2) in vec2 aNext;
+
+uniform vec2 uPosOffset;
+uniform vec2 uViewport;   // velicina cilja u pikselima
+uniform float uHalfWidth; // pola debljine linije u pikselima
+
+vec2 direction(vec2 from, vec2 to, vec2 fallback) {
+    vec2 d = to - from;
+    float len = length(d);
+    return len > 1e-4 ? d / len : fallback;
+}
+
+void main() {
+    // Racun u pikselima, da debljina bude ista u oba pravca i na svakoj rezoluciji
+    vec2 toPixels = uViewport * 0.5;
+    vec2 prev = aPrev * toPixels;
+    vec2 pos = aPos * toPixels;
+    vec2 next = aNext * toPixels;
+
+    vec2 dirOut = direction(pos, next, vec2(1.0, 0.0));
+    vec2 dirIn = direction(prev, pos, dirOut);
+    vec2 tangent = direction(-dirIn, dirOut, dirIn);
+    vec2 normal = vec2(-dirIn.y, dirIn.x);
+    vec2 miter = vec2(-tangent.y, tangent.x);
+    // Spoj pod uglom: ivica se produzava do preseka, najvise 4 puta debljina
+    float miterLength = uHalfWidth / max(dot(miter, normal), 0.25);
+    float side = (gl_VertexID & 1) == 0 ? 1.0 : -1.0;
+
+    gl_Position = vec4(aPos + uPosOffset + miter * miterLength * side / toPixels, 0.0, 1.0);
+}
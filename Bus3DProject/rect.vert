@@ -1,16 +1,15 @@
 #version 330 core
 layout (location = 0) in vec2 aPos;
 layout (location = 1) in vec2 aTexCoord;
+// Po instanci (SpriteBatch): x, y, velicina i deo teksture (u0, v0, u1, v1)
+layout (location = 2) in vec3 aInstance;
+layout (location = 3) in vec4 aUvRect;
 
 out vec2 TexCoord;
 
-uniform float uX;
-uniform float uY;
-uniform float uS;
-
 void main() {
-    vec2 scaled = aPos * uS;
-    vec2 positioned = scaled + vec2(uX, uY);
+    vec2 scaled = aPos * aInstance.z;
+    vec2 positioned = scaled + aInstance.xy;
     gl_Position = vec4(positioned, 0.0, 1.0);
-    TexCoord = aTexCoord;
+    TexCoord = mix(aUvRect.xy, aUvRect.zw, aTexCoord);
 }
@@ -0,0 +1,19 @@
+#version 330 core
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in vec2 aTexCoord;
+
+out vec2 TexCoord;
+
+// Stari nacin: pozicija i velicina stanice kao uniforme, postavljaju se pre svakog crtanja
+// (samo za --bench-stations)
+uniform float uX;
+uniform float uY;
+uniform float uS;
+uniform vec4 uUvRect;
+
+void main() {
+    vec2 scaled = aPos * uS;
+    vec2 positioned = scaled + vec2(uX, uY);
+    gl_Position = vec4(positioned, 0.0, 1.0);
+    TexCoord = mix(uUvRect.xy, uUvRect.zw, aTexCoord);
+}